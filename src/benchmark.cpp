@@ -0,0 +1,378 @@
+#include "bigint.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <map>
+
+using namespace std;
+
+/*  Benchmarks every basic bigint operation over a sweep of operand sizes, from 1 to about 10^6 limbs.
+    Each measurement reports the time per operation, the number of limbs processed per second and the number of
+    allocations per operation. Results can be written as JSON, and compared against a previous run to catch
+    regressions:
+
+        benchmark --json results.json
+        benchmark --compare benchmark_baseline.json --tolerance 0.15
+
+    Everything runs on the calling thread: the allocation counter is installed as the bigint memory resource,
+    which keeps parallel algorithms serial.
+*/
+
+
+/**
+ * @brief Memory resource that counts the allocations going through it, and gets the memory from new and delete.
+ * 
+ */
+class counting_resource : public pmr::memory_resource {
+
+public:
+    uint64_t allocations = 0;
+
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+
+/**
+ * @brief One measurement.
+ * 
+ */
+struct benchmark_result {
+    string operation;
+    uint64_t limbs;
+    double ns_per_op;
+    double limbs_per_second;
+    double allocations_per_op;
+};
+
+
+/**
+ * @brief Command line options.
+ * 
+ */
+struct benchmark_options {
+    uint64_t max_limbs = 1 << 20;
+    double min_time = 0.1;
+    double tolerance = 0.1;
+    string json_path;
+    string baseline_path;
+    vector<string> operations = {"add", "sub", "mul", "square", "divide", "compare", "parse", "format", "copy"};
+};
+
+
+/**
+ * @brief Used to keep results alive, so that the compiler cannot drop the operations being measured.
+ * 
+ */
+static volatile uint64_t sink = 0;
+
+
+/**
+ * @brief Returns a random positive bigint of exactly size limbs. Built from a hexadecimal string, in linear time.
+ * 
+ * @param generator 
+ * @param size 
+ * @return bigint 
+ */
+static bigint random_bigint(mt19937_64& generator, const uint64_t& size) {
+    ostringstream digits;
+    digits << hex << (generator() | (1ULL << 63));
+    for (uint64_t i = 1; i < size; i++) {
+        digits << setw(16) << setfill('0') << generator();
+    }
+    return bigint(digits.str(), 16);
+}
+
+
+/**
+ * @brief   Runs operation until at least min_time seconds have elapsed, doubling the number of runs between clock
+ *          reads, and measures it. Allocations are counted through resource, which must be current.
+ * 
+ * @param name 
+ * @param limbs 
+ * @param min_time 
+ * @param resource 
+ * @param operation 
+ * @return benchmark_result 
+ */
+static benchmark_result measure(const string& name, const uint64_t& limbs, const double& min_time, counting_resource& resource,
+                                const function<void()>& operation) {
+    //  One warm up run fills the per-thread caches (scratch buffers, powers of 10...).
+    operation();
+
+    uint64_t runs = 0, batch = 1;
+    uint64_t allocations = resource.allocations;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    double elapsed = 0;
+    while (elapsed < min_time) {
+        for (uint64_t i = 0; i < batch; i++) {
+            operation();
+        }
+        runs += batch;
+        batch *= 2;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    benchmark_result result;
+    result.operation = name;
+    result.limbs = limbs;
+    result.ns_per_op = elapsed * 1e9 / (double) runs;
+    result.limbs_per_second = (double) limbs * (double) runs / elapsed;
+    result.allocations_per_op = (double) (resource.allocations - allocations) / (double) runs;
+    return result;
+}
+
+
+/**
+ * @brief Measures all the requested operations on operands of size limbs.
+ * 
+ * @param limbs 
+ * @param options 
+ * @param resource 
+ * @return vector<benchmark_result> 
+ */
+static vector<benchmark_result> benchmark_size(const uint64_t& limbs, const benchmark_options& options, counting_resource& resource) {
+    mt19937_64 generator(limbs);
+    bigint a = random_bigint(generator, limbs), b = random_bigint(generator, limbs);
+    bigint a_copy = a;
+    bigint dividend = a * b + a;
+    string decimal = a.to_string();
+
+    map<string, function<void()>> operations = {
+        {"add", [&]() { sink += (a + b).bit_length(); }},
+        {"sub", [&]() { sink += (a - b).bit_length(); }},
+        {"mul", [&]() { sink += (a * b).bit_length(); }},
+        {"square", [&]() { sink += a.square().bit_length(); }},
+        {"divide", [&]() { sink += (dividend / b).bit_length(); }},
+        {"compare", [&]() { sink += (uint64_t) a.compare(a_copy); }},
+        {"parse", [&]() { sink += bigint(decimal).bit_length(); }},
+        {"format", [&]() { sink += a.to_string().size(); }},
+        {"copy", [&]() { sink += bigint(a).bit_length(); }},
+    };
+
+    vector<benchmark_result> results;
+    for (const string& name : options.operations) {
+        results.push_back(measure(name, limbs, options.min_time, resource, operations.at(name)));
+    }
+    return results;
+}
+
+
+/**
+ * @brief Writes results as a JSON document, one result per line.
+ * 
+ * @param os 
+ * @param results 
+ */
+static void write_json(ostream& os, const vector<benchmark_result>& results) {
+    os << "{\n  \"results\": [\n";
+    for (uint64_t i = 0; i < results.size(); i++) {
+        const benchmark_result& r = results[i];
+        os << "    {\"operation\": \"" << r.operation << "\", \"limbs\": " << r.limbs << fixed << setprecision(3)
+           << ", \"ns_per_op\": " << r.ns_per_op << ", \"limbs_per_second\": " << r.limbs_per_second
+           << ", \"allocations_per_op\": " << r.allocations_per_op << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        os.unsetf(ios::floatfield);
+    }
+    os << "  ]\n}\n";
+}
+
+
+/**
+ * @brief Returns the value of a field of a JSON object written on a single line, as written by write_json.
+ * 
+ * @param line 
+ * @param key 
+ * @return string Empty if the field is missing. 
+ */
+static string json_field(const string& line, const string& key) {
+    string pattern = "\"" + key + "\": ";
+    size_t start = line.find(pattern);
+    if (start == string::npos) {
+        return "";
+    }
+    start += pattern.size();
+    if (line[start] == '"') {
+        return line.substr(start + 1, line.find('"', start + 1) - start - 1);
+    }
+    return line.substr(start, line.find_first_of(",}", start) - start);
+}
+
+
+/**
+ * @brief Reads results written by write_json. Throws an invalid_argument if the file cannot be read.
+ * 
+ * @param path 
+ * @return vector<benchmark_result> 
+ */
+static vector<benchmark_result> read_json(const string& path) {
+    ifstream file(path);
+    if (!file) {
+        throw invalid_argument("Cannot read " + path + ".");
+    }
+
+    vector<benchmark_result> results;
+    string line;
+    while (getline(file, line)) {
+        string operation = json_field(line, "operation");
+        if (operation.empty()) {
+            continue;
+        }
+        benchmark_result result;
+        result.operation = operation;
+        result.limbs = stoull(json_field(line, "limbs"));
+        result.ns_per_op = stod(json_field(line, "ns_per_op"));
+        result.limbs_per_second = stod(json_field(line, "limbs_per_second"));
+        result.allocations_per_op = stod(json_field(line, "allocations_per_op"));
+        results.push_back(result);
+    }
+    return results;
+}
+
+
+/**
+ * @brief   Prints how results compare to baseline. Results more than tolerance slower than their baseline, or that
+ *          allocate more, are flagged. Returns the number of flagged results.
+ * 
+ * @param results 
+ * @param baseline 
+ * @param tolerance 
+ * @return uint64_t 
+ */
+static uint64_t compare_results(const vector<benchmark_result>& results, const vector<benchmark_result>& baseline, const double& tolerance) {
+    map<pair<string, uint64_t>, benchmark_result> reference;
+    for (const benchmark_result& r : baseline) {
+        reference[make_pair(r.operation, r.limbs)] = r;
+    }
+
+    uint64_t regressions = 0;
+    cout << "\noperation     limbs     baseline ns/op      current ns/op    ratio\n";
+    for (const benchmark_result& r : results) {
+        auto found = reference.find(make_pair(r.operation, r.limbs));
+        if (found == reference.end()) {
+            continue;
+        }
+        const benchmark_result& old = found->second;
+        double ratio = r.ns_per_op / old.ns_per_op;
+        bool slower = ratio > 1 + tolerance;
+        bool allocates_more = r.allocations_per_op > old.allocations_per_op + 0.5;
+
+        cout << left << setw(10) << r.operation << right << setw(10) << r.limbs << fixed << setprecision(1)
+             << setw(19) << old.ns_per_op << setw(19) << r.ns_per_op << setprecision(2) << setw(9) << ratio
+             << (slower ? "  SLOWER" : "") << (allocates_more ? "  MORE ALLOCATIONS" : "") << "\n";
+        cout.unsetf(ios::floatfield);
+        if (slower or allocates_more) {
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+
+/**
+ * @brief Reads the command line. Throws an invalid_argument on unknown options.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return benchmark_options 
+ */
+static benchmark_options parse_options(int argc, char** argv) {
+    benchmark_options options;
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 >= argc) {
+            throw invalid_argument("Missing value for " + option + ".");
+        }
+        string value = argv[++i];
+
+        if (option == "--max-limbs") {
+            options.max_limbs = stoull(value);
+        }
+        else if (option == "--min-time") {
+            options.min_time = stod(value);
+        }
+        else if (option == "--json") {
+            options.json_path = value;
+        }
+        else if (option == "--compare") {
+            options.baseline_path = value;
+        }
+        else if (option == "--tolerance") {
+            options.tolerance = stod(value);
+        }
+        else if (option == "--operations") {
+            vector<string> known = options.operations;
+            options.operations.clear();
+            stringstream names(value);
+            string name;
+            while (getline(names, name, ',')) {
+                if (find(known.begin(), known.end(), name) == known.end()) {
+                    throw invalid_argument("Unknown operation " + name + ".");
+                }
+                options.operations.push_back(name);
+            }
+        }
+        else {
+            throw invalid_argument("Unknown option " + option + ".");
+        }
+    }
+    return options;
+}
+
+
+int main(int argc, char** argv) {
+    benchmark_options options;
+    try {
+        options = parse_options(argc, argv);
+    }
+    catch (const exception& error) {
+        cerr << error.what() << "\n"
+             << "Usage: benchmark [--max-limbs N] [--min-time SECONDS] [--operations add,mul,...] [--json FILE]\n"
+             << "                 [--compare BASELINE] [--tolerance FRACTION]\n";
+        return 2;
+    }
+
+    counting_resource resource;
+    vector<benchmark_result> results;
+    {
+        bigint_resource_scope scope(&resource);
+
+        cout << "operation     limbs          ns/op        limbs/s   allocs/op\n";
+        //  Sizes grow by factors of 4, from 1 to 2^20 limbs by default.
+        for (uint64_t limbs = 1; limbs <= options.max_limbs; limbs *= 4) {
+            for (const benchmark_result& r : benchmark_size(limbs, options, resource)) {
+                cout << left << setw(10) << r.operation << right << setw(10) << r.limbs << fixed << setprecision(1)
+                     << setw(15) << r.ns_per_op << scientific << setprecision(3) << setw(15) << r.limbs_per_second
+                     << fixed << setprecision(2) << setw(12) << r.allocations_per_op << endl;
+                cout.unsetf(ios::floatfield);
+                results.push_back(r);
+            }
+        }
+    }
+
+    if (!options.json_path.empty()) {
+        ofstream file(options.json_path);
+        write_json(file, results);
+    }
+
+    if (!options.baseline_path.empty()) {
+        uint64_t regressions = compare_results(results, read_json(options.baseline_path), options.tolerance);
+        cout << "\n" << regressions << " regression(s) over a " << options.tolerance * 100 << "% tolerance.\n";
+        return regressions > 0 ? 1 : 0;
+    }
+    return 0;
+}
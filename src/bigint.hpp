@@ -6,9 +6,432 @@
 #include <stdexcept>
 #include <cstdint>
 #include <cmath>
+#include <utility>
+#include <algorithm>
+#include <memory_resource>
+#include <cstring>
+#include <cctype>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <chrono>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(BIGINT_NO_SIMD)
+#define BIGINT_X86_64
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
+/**
+ * @brief   Returns the memory resource the calling thread's bigints and scratch buffers are currently allocated from.
+ *          Defaults to the global heap (new and delete). See bigint_resource_scope to change it.
+ * 
+ * @return pmr::memory_resource* 
+ */
+static pmr::memory_resource* bigint_memory_resource();
+
+
+/**
+ * @brief   Makes the calling thread allocate bigint limbs and scratch buffers from the given memory resource for as long
+ *          as the scope object lives. Scopes can be nested, the previous resource is restored on destruction.
+ *          A bigint keeps the resource it was allocated from for its whole life, so it must not outlive it.
+ * 
+ */
+class bigint_resource_scope {
+
+public:
+    /**
+     * @brief Starts allocating from resource.
+     * 
+     * @param resource 
+     */
+    explicit bigint_resource_scope(pmr::memory_resource* resource);
+
+    /**
+     * @brief Goes back to the resource that was used before the scope was created.
+     * 
+     */
+    ~bigint_resource_scope();
+
+    bigint_resource_scope(const bigint_resource_scope&) = delete;
+    bigint_resource_scope& operator=(const bigint_resource_scope&) = delete;
+
+
+private:
+    pmr::memory_resource* previous;
+};
+
+
+/**
+ * @brief   Bump allocator for batches of short-lived bigints. Allocating is a pointer increment, deallocating does nothing,
+ *          and all the memory is reclaimed at once by reset(), which keeps the underlying blocks for the next batch.
+ *          Not thread-safe: use one arena per thread.
+ * 
+ */
+class bigint_arena : public pmr::memory_resource {
+
+public:
+    /**
+     * @brief Construct a new arena.
+     * 
+     * @param block_size Size in bytes of the blocks requested from upstream. Larger allocations get a block of their own.
+     * @param upstream Where blocks come from.
+     */
+    explicit bigint_arena(const size_t& block_size = 1 << 20, pmr::memory_resource* upstream = pmr::new_delete_resource());
+
+    /**
+     * @brief Gives all blocks back to upstream.
+     * 
+     */
+    ~bigint_arena();
+
+    bigint_arena(const bigint_arena&) = delete;
+    bigint_arena& operator=(const bigint_arena&) = delete;
+
+    /**
+     * @brief   Reclaims everything allocated from the arena in one go. Every bigint allocated from it becomes invalid.
+     *          The blocks are kept, so the next batch does not go to upstream at all.
+     * 
+     */
+    void reset();
+
+    /**
+     * @brief Returns the number of bytes handed out since the last reset.
+     * 
+     * @return size_t 
+     */
+    size_t bytes_used() const;
+
+
+private:
+    struct block {
+        char* memory;
+        size_t size;
+    };
+
+    vector<block> blocks;
+    size_t current_block;
+    size_t offset;
+    size_t used;
+    size_t default_block_size;
+    pmr::memory_resource* upstream;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override;
+};
+
+
+/**
+ * @brief   Sets the number of threads parallel algorithms (product trees for instance) spread their work across, the
+ *          calling thread included. 0 means one per hardware thread, which is the default, and 1 makes everything
+ *          serial. Must not be called while a parallel algorithm runs.
+ * 
+ * @param count 
+ */
+void set_bigint_thread_count(const uint64_t& count);
+
+/**
+ * @brief Returns the number of threads parallel algorithms use. See set_bigint_thread_count.
+ * 
+ * @return uint64_t 
+ */
+uint64_t bigint_thread_count();
+
+/**
+ * @brief   Enables or disables parallel multiplication, which is disabled by default. When enabled, products whose
+ *          operands have at least PARALLEL_MUL_THRESHOLD limbs spread their independent sub-products across threads
+ *          (see set_bigint_thread_count). Must not be called while a product runs.
+ * 
+ * @param enabled 
+ */
+void set_bigint_parallel_multiplication(const bool& enabled);
+
+/**
+ * @brief Returns whether parallel multiplication is enabled. See set_bigint_parallel_multiplication.
+ * 
+ * @return bool 
+ */
+bool bigint_parallel_multiplication();
+
+/**
+ * @brief   Counters of one kind of operation, see bigint_stats. An operation running inside an other one (a product
+ *          inside a conversion for instance) counts for both.
+ * 
+ */
+struct bigint_operation_stats {
+    /**
+     * @brief Number of times the operation was called.
+     * 
+     */
+    uint64_t calls;
+
+    /**
+     * @brief Total size (in limbs) of the operands.
+     * 
+     */
+    uint64_t limbs;
+
+    /**
+     * @brief Heap allocations of bigint limbs made by the calling thread while the operation ran.
+     * 
+     */
+    uint64_t allocations;
+
+    /**
+     * @brief Bytes of bigint limbs copied by the calling thread while the operation ran.
+     * 
+     */
+    uint64_t bytes_copied;
+};
+
+
+/**
+ * @brief   Snapshot of the counters kept when the library is compiled with BIGINT_STATS defined (before including
+ *          bigint.hpp). Without it, the counters are compiled out and always 0.
+ * 
+ */
+struct bigint_stats {
+    /**
+     * @brief Additions and subtractions, builtin integer operands included.
+     * 
+     */
+    bigint_operation_stats add;
+
+    /**
+     * @brief Products and squares, fused ones (addmul, submul) and builtin integer operands included.
+     * 
+     */
+    bigint_operation_stats multiply;
+
+    /**
+     * @brief Divisions and remainders, builtin integer operands included.
+     * 
+     */
+    bigint_operation_stats divide;
+
+    /**
+     * @brief Conversions to strings.
+     * 
+     */
+    bigint_operation_stats to_string;
+
+    /**
+     * @brief Conversions from strings. limbs counts the limbs of the results.
+     * 
+     */
+    bigint_operation_stats from_string;
+
+    /**
+     * @brief Copy constructions and copy assignments.
+     * 
+     */
+    bigint_operation_stats copy;
+
+    /**
+     * @brief   Number of products (squares included) computed by each algorithm, recursive calls included. Unbalanced
+     *          products are the ones cut into balanced chunks first.
+     * 
+     */
+    uint64_t schoolbook_products;
+    uint64_t karatsuba_products;
+    uint64_t toom3_products;
+    uint64_t ntt_products;
+    uint64_t unbalanced_products;
+};
+
+/**
+ * @brief Returns the current value of the counters, summed over all threads. See bigint_stats.
+ * 
+ * @return bigint_stats 
+ */
+bigint_stats bigint_stats_snapshot();
+
+/**
+ * @brief Sets all the counters back to 0.
+ * 
+ */
+void reset_bigint_stats();
+
+/**
+ * @brief   Sets a function called at the end of each counted operation with the name of the operation ("add",
+ *          "multiply", "divide", "to_string", "from_string" or "copy") and its duration in nanoseconds, to feed a
+ *          metrics exporter for instance. Operations are only timed while a timer is set: pass an empty function to
+ *          stop. Must not be called while other threads use bigints. Does nothing without BIGINT_STATS.
+ * 
+ * @param timer 
+ */
+void set_bigint_stats_timer(const function<void(const char*, const uint64_t&)>& timer);
+
+
+/**
+ * @brief Vector type used for scratch buffers inside algorithms. Allocated from bigint_memory_resource().
+ * 
+ */
+typedef pmr::vector<uint64_t> scratch_vector;
+
+
+/**
+ * @brief   Growable array of limbs used to store bigint values. The first few limbs are stored inside the object
+ *          itself and the heap is only used once the value grows past them, so that typical 64 to 256 bits values
+ *          never allocate. Larger arrays come from the memory resource that was current when the limb_vector was
+ *          created. Only provides the part of std::vector's interface bigint needs.
+ * 
+ */
+class limb_vector {
+
+public:
+    /**
+     * @brief Number of limbs stored inline, without any allocation.
+     * 
+     */
+    static constexpr uint64_t INLINE_CAPACITY = 4;
+
+    /**
+     * @brief Construct an empty limb_vector.
+     * 
+     */
+    limb_vector();
+
+    /**
+     * @brief Construct a limb_vector of size limbs, all equal to value.
+     * 
+     * @param size 
+     * @param value 
+     */
+    limb_vector(const uint64_t& size, const uint64_t& value);
+
+    /**
+     * @brief Construct a limb_vector from an other limb_vector. Only allocates if the source does not fit inline.
+     * 
+     * @param source 
+     */
+    limb_vector(const limb_vector& source);
+
+    /**
+     * @brief Construct a limb_vector by taking over the storage and memory resource of source, which is left empty.
+     * 
+     * @param source 
+     */
+    limb_vector(limb_vector&& source) noexcept;
+
+    ~limb_vector();
+
+    /**
+     * @brief Copies source to the caller. Reuses the caller's storage when it is large enough.
+     * 
+     * @param source 
+     * @return limb_vector& 
+     */
+    limb_vector& operator=(const limb_vector& source);
+
+    /**
+     * @brief   Takes over the storage of source, which is left empty. Falls back to a copy when both do not allocate
+     *          from the same memory resource.
+     * 
+     * @param source 
+     * @return limb_vector& 
+     */
+    limb_vector& operator=(limb_vector&& source);
+
+    uint64_t size() const;
+    uint64_t capacity() const;
+    bool empty() const;
+    uint64_t* data();
+    const uint64_t* data() const;
+    uint64_t* begin();
+    const uint64_t* begin() const;
+    uint64_t* end();
+    const uint64_t* end() const;
+    uint64_t& operator[](const uint64_t& index);
+    const uint64_t& operator[](const uint64_t& index) const;
+    uint64_t& back();
+    const uint64_t& back() const;
+
+    /**
+     * @brief Makes sure that at least new_capacity limbs can be stored without allocating.
+     * 
+     * @param new_capacity 
+     */
+    void reserve(const uint64_t& new_capacity);
+
+    /**
+     * @brief Changes the number of limbs. New limbs are set to value.
+     * 
+     * @param new_size 
+     * @param value 
+     */
+    void resize(const uint64_t& new_size, const uint64_t& value = 0ULL);
+
+    /**
+     * @brief Replaces the content with size limbs equal to value.
+     * 
+     * @param size 
+     * @param value 
+     */
+    void assign(const uint64_t& size, const uint64_t& value);
+
+    /**
+     * @brief Replaces the content with the limbs in [first, last).
+     * 
+     * @param first 
+     * @param last 
+     */
+    void assign(const uint64_t* first, const uint64_t* last);
+
+    void push_back(const uint64_t& value);
+    void pop_back();
+    void clear();
+
+    bool operator==(const limb_vector& other) const;
+    bool operator!=(const limb_vector& other) const;
+
+
+private:
+    /**
+     * @brief Points either to inline_limbs or to a heap allocated array.
+     * 
+     */
+    uint64_t* limbs;
+
+    uint64_t length;
+
+    uint64_t allocated;
+
+    uint64_t inline_limbs[INLINE_CAPACITY];
+
+    /**
+     * @brief Where heap storage is allocated from.
+     * 
+     */
+    pmr::memory_resource* resource;
+
+    /**
+     * @brief Whether limbs points to the heap.
+     * 
+     */
+    bool is_heap() const;
+
+    /**
+     * @brief Moves the content to a storage of exactly new_capacity limbs.
+     * 
+     * @param new_capacity 
+     */
+    void reallocate(const uint64_t& new_capacity);
+};
+
+
 /**
  * @brief Class for storing arbitrary sized unsigned integers.
  * 
@@ -30,11 +453,13 @@ public:
     bigint(const int64_t& initial_value);
 
     /**
-     * @brief Construct a new bigint object from a string of numbers.
+     * @brief Construct a new bigint object from a string of digits in the given base, with an optional leading '-'.
      * 
-     * @param initial_value Should only contain numbers.
+     * @param initial_value Should only contain digits of the base, letters of either case for bases above 10. Throws
+     *                      an invalid_argument otherwise.
+     * @param base From 2 to 36, throws an invalid_argument otherwise.
      */
-    bigint(const string& initial_value);
+    bigint(const string& initial_value, const uint64_t& base = 10);
 
     /**
      * @brief Construct a new bigint object from an other bigint object.
@@ -44,7 +469,16 @@ public:
     bigint(const bigint& source_int);
 
     /**
-     * @brief Outputs the number in base 10.
+     * @brief   Construct a new bigint object by taking over the limbs of source_int, without copying them.
+     *          source_int is left equal to 0.
+     * 
+     * @param source_int 
+     */
+    bigint(bigint&& source_int) noexcept;
+
+    /**
+     * @brief   Outputs the number in base 10, or in base 16 or 8 if the stream is set to std::hex or std::oct.
+     *          std::showbase and std::uppercase are honored as for builtin integers.
      * 
      * @param os 
      * @param number 
@@ -53,25 +487,38 @@ public:
     friend ostream& operator<<(ostream& os, const bigint& number);
 
     /**
-     * @brief Returns the number in base 10.
+     * @brief   Returns the number in the given base, with lower case letters for digits above 9. Powers of 2 bases
+     *          take a single pass over the limbs.
      * 
+     * @param base From 2 to 36, throws an invalid_argument otherwise.
      * @return string 
      */
-    string to_string() const;
+    string to_string(const uint64_t& base = 10) const;
 
     /**
-     * @brief Copies the r_value bigint to the l_value bigint.
+     * @brief Copies the r_value bigint to the l_value bigint. Reuses the l_value's storage when it is large enough.
      * 
      * @param int_to_copy 
+     * @return bigint& 
+     */
+    bigint& operator=(const bigint& r_value);
+
+    /**
+     * @brief   Moves the r_value bigint to the l_value bigint, without copying its limbs unless they come from an other
+     *          memory resource. r_value is left equal to 0.
+     * 
+     * @param r_value 
+     * @return bigint& 
      */
-    void operator=(const bigint& r_value);
+    bigint& operator=(bigint&& r_value);
     
     /**
      * @brief Assigns the r_value string of digits to the l_value bigint.
      * 
      * @param r_value String of digits.
+     * @return bigint& 
      */
-    void operator=(const string& r_value);
+    bigint& operator=(const string& r_value);
 
     /**
      * @brief   Compares both bigints. Returns 1 if caller is greater, 0 if it is equal, -1 else.
@@ -143,797 +590,7783 @@ public:
      * @brief Adds the numerical value of second_int to the caller's.
      * 
      * @param second_int 
+     * @return bigint& 
      */
-    void operator+=(const bigint& second_int);
+    bigint& operator+=(const bigint& second_int);
 
     /**
      * @brief Substracts the numerical value of second_int from the caller's.
      * 
      * @param second_int 
+     * @return bigint& 
      */
-    void operator-=(const bigint& second_int);
+    bigint& operator-=(const bigint& second_int);
 
     /**
      * @brief Multiplies the caller's numerical value by second_int's.
      * 
      * @param second_int 
+     * @return bigint& 
      */
-    void operator*=(const bigint& second_int);
+    bigint& operator*=(const bigint& second_int);
 
     /**
-     * @brief Changes the caller's sign.
+     * @brief Returns the opposite of the caller.
      * 
      * @return bigint 
      */
-    bigint operator-();
+    bigint operator-() const&;
 
     /**
-     * @brief Computes the product of the caller and second_int's numerical values and returns the result.
+     * @brief Returns the opposite of a temporary, reusing its limbs.
      * 
-     * @param second_int 
      * @return bigint 
      */
-    bigint operator*(const bigint& second_int) const;
+    bigint operator-() &&;
 
     /**
-     * @brief Computes the sum of the caller and second_int's numerical values and returns the result.
+     * @brief   Computes the product of the caller and second_int's numerical values and returns the result.
+     *          The overloads taking temporaries reuse their storage, so chained expressions do not copy limbs around.
      * 
      * @param second_int 
      * @return bigint 
      */
-    bigint operator+(const bigint& second_int) const;
+    bigint operator*(const bigint& second_int) const&;
+    bigint operator*(const bigint& second_int) &&;
+    bigint operator*(bigint&& second_int) const&;
+    bigint operator*(bigint&& second_int) &&;
 
     /**
-     * @brief Computes the difference between the caller and second_int's numerical values and returns the result.
+     * @brief   Computes the sum of the caller and second_int's numerical values and returns the result.
+     *          The overloads taking temporaries reuse their storage, so chained expressions do not copy limbs around.
      * 
      * @param second_int 
      * @return bigint 
      */
-    bigint operator-(const bigint& second_int) const;
+    bigint operator+(const bigint& second_int) const&;
+    bigint operator+(const bigint& second_int) &&;
+    bigint operator+(bigint&& second_int) const&;
+    bigint operator+(bigint&& second_int) &&;
 
-
-private:
     /**
-     * @brief Stores the value of bigint represented in base 2^64. Index 0 of the vector is the least significant component.
+     * @brief   Computes the difference between the caller and second_int's numerical values and returns the result.
+     *          The overloads taking temporaries reuse their storage, so chained expressions do not copy limbs around.
      * 
+     * @param second_int 
+     * @return bigint 
      */
-    vector<uint64_t> values;
+    bigint operator-(const bigint& second_int) const&;
+    bigint operator-(const bigint& second_int) &&;
+    bigint operator-(bigint&& second_int) const&;
+    bigint operator-(bigint&& second_int) &&;
 
     /**
-     * @brief Stores the sign of the bigint. 1 is positive, -1 is negative.
+     * @brief   Computes the quotient of the caller by divisor, rounded towards 0 like for builtin integers.
+     *          Throws domain_error if divisor is 0.
      * 
+     * @param divisor 
+     * @return bigint 
      */
-    int8_t sign;
+    bigint operator/(const bigint& divisor) const;
 
     /**
-     * @brief Assigns the value represented by a string of digits to the bigint.
+     * @brief   Computes the remainder of the division of the caller by divisor. It has the sign of the caller,
+     *          like for builtin integers. Throws domain_error if divisor is 0.
      * 
-     * @param number String of digits.
+     * @param divisor 
+     * @return bigint 
      */
-    void assign_string(const string& number);
+    bigint operator%(const bigint& divisor) const;
 
     /**
-     * @brief   Assigns the result of the addition with second_int to the caller.
-     *          I was very sick when I wrote this and it shows, sorry. Should be split up into more functions for encapsulation.
+     * @brief Divides the caller by divisor. See operator/.
      * 
-     * @param second_int bigint to add to the caller.
-     * @param add_sign Sign of the operation to perform. 1 or -1;
+     * @param divisor 
+     * @return bigint& 
      */
-    void assign_add(const bigint& second_int, const int8_t& add_sign);
+    bigint& operator/=(const bigint& divisor);
 
     /**
-     * @brief   Removes fields of values that represent useless 0s at the front of a number.
-     *          Used for cleaning up bigints after some operations.
+     * @brief Replaces the caller by the remainder of its division by divisor. See operator%.
      * 
+     * @param divisor 
+     * @return bigint& 
      */
-    void remove_empty_values();
+    bigint& operator%=(const bigint& divisor);
 
     /**
-     * @brief   Set all existing fields of values to 0.
-     *          Used for multiplication.
+     * @brief   Returns the caller multiplied by 2^bits, in a single pass over its limbs.
      * 
+     * @param bits 
+     * @return bigint 
      */
-    void set_values_to_zero();
-};
-
+    bigint operator<<(const uint64_t& bits) const;
 
+    /**
+     * @brief   Returns the caller divided by 2^bits, rounded towards minus infinity like an arithmetic shift of its
+     *          two's complement: -5 >> 1 is -3. Only the limbs kept are read, in a single pass.
+     * 
+     * @param bits 
+     * @return bigint 
+     */
+    bigint operator>>(const uint64_t& bits) const;
 
+    /**
+     * @brief Shifts the caller to the left in place. See operator<<.
+     * 
+     * @param bits 
+     * @return bigint& 
+     */
+    bigint& operator<<=(const uint64_t& bits);
 
+    /**
+     * @brief Shifts the caller to the right in place. See operator>>.
+     * 
+     * @param bits 
+     * @return bigint& 
+     */
+    bigint& operator>>=(const uint64_t& bits);
 
+    /**
+     * @brief   Bitwise operators. Negative values behave as their infinite two's complement writing, as in GMP and
+     *          Python: -1 has all its bits set, and x & -x is the lowest set bit of x.
+     * 
+     * @param second_int 
+     * @return bigint 
+     */
+    bigint operator&(const bigint& second_int) const;
+    bigint operator|(const bigint& second_int) const;
+    bigint operator^(const bigint& second_int) const;
+    bigint& operator&=(const bigint& second_int);
+    bigint& operator|=(const bigint& second_int);
+    bigint& operator^=(const bigint& second_int);
 
+    /**
+     * @brief Returns the bitwise complement of the caller in two's complement, which is -caller - 1.
+     * 
+     * @return bigint 
+     */
+    bigint operator~() const;
+
+    /**
+     * @brief   Computes both the quotient and the remainder of the division of the caller by divisor, for the price of one.
+     *          Same conventions as operator/ and operator%.
+     * 
+     * @param divisor 
+     * @return pair<bigint, bigint> Quotient and remainder.
+     */
+    pair<bigint, bigint> divmod(const bigint& divisor) const;
+
+    /**
+     * @brief   Adds the product of a and b to the caller, without creating any temporary bigint.
+     *          Same as *this += a * b, but much cheaper in accumulation loops.
+     * 
+     * @param a 
+     * @param b 
+     */
+    void addmul(const bigint& a, const bigint& b);
+
+    /**
+     * @brief   Substracts the product of a and b from the caller, without creating any temporary bigint.
+     *          Same as *this -= a * b, but much cheaper in accumulation loops.
+     * 
+     * @param a 
+     * @param b 
+     */
+    void submul(const bigint& a, const bigint& b);
+
+    /**
+     * @brief Multiplies the caller by a single limb, in place.
+     * 
+     * @param factor 
+     */
+    void mul_small(const uint64_t& factor);
+
+    /**
+     * @brief   Returns the square of the caller. Cheaper than a general product, as each cross product is only
+     *          computed once. x * x and x *= x take the same path.
+     * 
+     * @return bigint 
+     */
+    bigint square() const;
+
+    /**
+     * @brief Returns the number of bits of the absolute value of the caller, 0 for 0.
+     * 
+     * @return uint64_t 
+     */
+    uint64_t bit_length() const;
+
+    /**
+     * @brief Returns bit index of the caller, in two's complement for negative values (see operator&).
+     * 
+     * @param index 
+     * @return bool 
+     */
+    bool test_bit(const uint64_t& index) const;
+
+    /**
+     * @brief Returns true if the caller can be converted to an int64_t without loss.
+     * 
+     * @return bool 
+     */
+    bool fits_int64() const;
+
+    /**
+     * @brief Returns the value of the caller as an int64_t. Throws an out_of_range if it does not fit (see fits_int64).
+     * 
+     * @return int64_t 
+     */
+    int64_t to_int64() const;
+
+    /**
+     * @brief   Arithmetic with builtin integers (int64_t, uint64_t and every other integer type). The operand is used as a
+     *          single limb, no temporary bigint is built. Same conventions as the bigint versions, / and % throw a
+     *          domain_error on 0.
+     * 
+     * @param n 
+     * @return bigint 
+     */
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint& operator+=(const T& n);
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint& operator-=(const T& n);
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint& operator*=(const T& n);
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint& operator/=(const T& n);
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint& operator%=(const T& n);
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator+(const T& n) const&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator+(const T& n) &&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator-(const T& n) const&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator-(const T& n) &&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator*(const T& n) const&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator*(const T& n) &&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator/(const T& n) const&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator/(const T& n) &&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator%(const T& n) const&;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator%(const T& n) &&;
+
+    /**
+     * @brief Compares the numerical values of the caller and a builtin integer, without building a temporary bigint.
+     * 
+     * @param n 
+     * @return true 
+     * @return false 
+     */
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator<(const T& n) const;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator>(const T& n) const;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator==(const T& n) const;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator<=(const T& n) const;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator>=(const T& n) const;
+    template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator!=(const T& n) const;
+
+
+private:
+    /**
+     * @brief   Stores the value of bigint represented in base 2^64. Index 0 of the vector is the least significant component.
+     *          Values of up to limb_vector::INLINE_CAPACITY limbs do not use the heap.
+     * 
+     */
+    limb_vector values;
+
+    /**
+     * @brief Stores the sign of the bigint. 1 is positive, -1 is negative.
+     * 
+     */
+    int8_t sign;
+
+    /**
+     * @brief Assigns the value represented by a string of digits to the bigint.
+     * 
+     * @param number String of digits, with an optional leading '-'.
+     * @param base From 2 to 36.
+     */
+    void assign_string(const string& number, const uint64_t& base);
+
+    /**
+     * @brief   Assigns the result of the addition with second_int to the caller, through the limb kernels.
+     *          second_int can be the caller.
+     * 
+     * @param second_int bigint to add to the caller.
+     * @param add_sign Sign of the operation to perform. 1 or -1;
+     */
+    void assign_add(const bigint& second_int, const int8_t& add_sign);
+
+    /**
+     * @brief Assigns the result of the addition with a * b to the caller, working directly on the caller's limbs.
+     * 
+     * @param a 
+     * @param b 
+     * @param add_sign Sign of the operation to perform. 1 or -1.
+     */
+    void assign_addmul(const bigint& a, const bigint& b, const int8_t& add_sign);
+
+    /**
+     * @brief   Removes fields of values that represent useless 0s at the front of a number.
+     *          Used for cleaning up bigints after some operations. Also makes sure zero is positive.
+     * 
+     */
+    void remove_empty_values();
+
+    /**
+     * @brief Assigns source * 2^bits to the caller. source can be the caller.
+     * 
+     * @param source 
+     * @param bits 
+     */
+    void assign_shift_left(const bigint& source, const uint64_t& bits);
+
+    /**
+     * @brief Assigns source / 2^bits, rounded towards minus infinity, to the caller. source can be the caller.
+     * 
+     * @param source 
+     * @param bits 
+     */
+    void assign_shift_right(const bigint& source, const uint64_t& bits);
+
+    /**
+     * @brief   Assigns the result of a bitwise operation with second_int to the caller, in a single pass that converts
+     *          both operands to two's complement and the result back on the fly.
+     * 
+     * @param second_int 
+     * @param operation '&', '|' or '^'.
+     */
+    void assign_bitwise(const bigint& second_int, const char& operation);
+
+    /**
+     * @brief   Returns a copy of the caller with room for one more limb, for results that can grow by a carry. The room
+     *          is only made when the copy is on the heap anyway: values that fit inline stay inline, and only allocate
+     *          if a carry actually comes out.
+     * 
+     * @return bigint 
+     */
+    bigint copy_with_carry_room() const;
+
+    /**
+     * @brief Splits a builtin integer into its absolute value, which fits in a single limb, and its sign.
+     * 
+     * @param n 
+     * @param n_sign Set to 1 or -1.
+     * @return uint64_t 
+     */
+    template<typename T>
+    static uint64_t split_integer(const T& n, int8_t& n_sign);
+
+    /**
+     * @brief Adds add_sign * magnitude to the caller, working directly on its limbs.
+     * 
+     * @param magnitude 
+     * @param add_sign 1 or -1.
+     */
+    void assign_add_small(const uint64_t& magnitude, const int8_t& add_sign);
+
+    /**
+     * @brief Same as compare, with a single limb value of sign small_sign.
+     * 
+     * @param magnitude 
+     * @param small_sign 1 or -1.
+     * @return int8_t 
+     */
+    int8_t compare_small(const uint64_t& magnitude, const int8_t& small_sign) const;
+
+    /**
+     * @brief   Divides the absolute value of the caller by divisor in place and returns the remainder. The sign is left
+     *          to the caller. Throws a domain_error if divisor is 0.
+     * 
+     * @param divisor 
+     * @return uint64_t 
+     */
+    uint64_t divrem_small(const uint64_t& divisor);
+
+    friend class montgomery_context;
+    friend bigint powmod(const bigint& base, const bigint& exponent, const bigint& modulus);
+    friend bigint gcd(const bigint& a, const bigint& b);
+    friend bigint lcm(const bigint& a, const bigint& b);
+    friend bigint extended_gcd(const bigint& a, const bigint& b, bigint& x, bigint& y);
+    friend bigint isqrt(const bigint& n);
+    friend bigint iroot(const bigint& n, const uint64_t& k);
+    friend bool is_perfect_square(const bigint& n);
+    friend class bigint_view;
+    friend uint64_t serialized_size(const bigint& value);
+    friend void serialize(const bigint& value, unsigned char* out, const bool& with_checksum);
+    friend void serialize(const bigint& value, ostream& os, const bool& with_checksum);
+    friend bigint deserialize(istream& is);
+    template<uint64_t Bits> friend class fixed_bigint;
+    template<char... Digits> friend bigint operator""_big();
+};
+
+
+/**
+ * @brief   Builtin integers on the left of +, -, * and comparisons, so that 2 * x or 0 < x work like x * 2 and x > 0,
+ *          without a temporary bigint.
+ * 
+ * @param n 
+ * @param number 
+ * @return bigint 
+ */
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator+(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator-(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bigint operator*(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator<(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator>(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator==(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator<=(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator>=(const T& n, const bigint& number);
+template<typename T, typename = enable_if_t<is_integral<T>::value>> bool operator!=(const T& n, const bigint& number);
+
+
+/**
+ * @brief   Precomputed data for fast arithmetic modulo a fixed odd modulus, using Montgomery's representation.
+ *          Building a context costs about one division, which is then saved on every product modulo the modulus.
+ *          Worth keeping around when many exponentiations share the same modulus, RSA keys for instance.
+ * 
+ */
+class montgomery_context {
+
+public:
+    /**
+     * @brief Construct a new context for the given modulus.
+     * 
+     * @param modulus Must be odd and positive, throws a domain_error otherwise.
+     */
+    explicit montgomery_context(const bigint& modulus);
+
+    /**
+     * @brief   Computes base^exponent modulo the context's modulus, using sliding window exponentiation.
+     *          No allocation happens inside the exponent loop.
+     * 
+     * @param base Any bigint, negative ones included.
+     * @param exponent Must not be negative, throws a domain_error otherwise.
+     * @return bigint Value in [0, modulus).
+     */
+    bigint powmod(const bigint& base, const bigint& exponent) const;
+
+    /**
+     * @brief Returns the modulus the context was built for.
+     * 
+     * @return const bigint& 
+     */
+    const bigint& modulus() const;
+
+
+private:
+    bigint modulus_value;
+
+    /**
+     * @brief Number of limbs of the modulus. R = 2^(64 * size).
+     * 
+     */
+    uint64_t size;
+
+    /**
+     * @brief -1 / modulus mod R. Only its first limb is used below MONTGOMERY_REDC_THRESHOLD.
+     * 
+     */
+    vector<uint64_t> modulus_inverse;
+
+    /**
+     * @brief R^2 mod modulus, used to move values to Montgomery form.
+     * 
+     */
+    vector<uint64_t> r_squared;
+
+    /**
+     * @brief   Montgomery reduction: writes t / R mod modulus to result, which does not need to be reduced further.
+     *          t has 2 * size + 1 limbs, is less than modulus * R and is overwritten.
+     * 
+     * @param result size limbs.
+     * @param t 
+     * @param scratch 4 * size limbs.
+     */
+    void reduce(uint64_t* result, uint64_t* t, uint64_t* scratch) const;
+
+    /**
+     * @brief Writes a * b / R mod modulus to result. a and b are size limbs and less than the modulus.
+     * 
+     * @param result size limbs. Can be the same as a or b.
+     * @param a 
+     * @param b 
+     * @param t 2 * size + 1 limbs.
+     * @param scratch 4 * size limbs.
+     */
+    void multiply(uint64_t* result, const uint64_t* a, const uint64_t* b, uint64_t* t, uint64_t* scratch) const;
+};
+
+
+/**
+ * @brief   Computes base^exponent modulo modulus. Odd moduli go through a montgomery_context, even ones through
+ *          plain divisions. To reuse the precomputations for the same modulus, see montgomery_context.
+ * 
+ * @param base Any bigint, negative ones included.
+ * @param exponent Must not be negative, throws a domain_error otherwise.
+ * @param modulus Must be positive, throws a domain_error otherwise.
+ * @return bigint Value in [0, modulus).
+ */
+bigint powmod(const bigint& base, const bigint& exponent, const bigint& modulus);
+
+/**
+ * @brief Computes base^exponent by binary exponentiation. pow(0, 0) is 1.
+ * 
+ * @param base 
+ * @param exponent 
+ * @return bigint 
+ */
+bigint pow(const bigint& base, const uint64_t& exponent);
+
+/**
+ * @brief   Greatest common divisor of a and b, always positive, and 0 if both are 0. Uses Lehmer's algorithm, and the
+ *          half-gcd algorithm on large operands.
+ * 
+ * @param a 
+ * @param b 
+ * @return bigint 
+ */
+bigint gcd(const bigint& a, const bigint& b);
+
+/**
+ * @brief Least common multiple of a and b, always positive, and 0 if either is 0.
+ * 
+ * @param a 
+ * @param b 
+ * @return bigint 
+ */
+bigint lcm(const bigint& a, const bigint& b);
+
+/**
+ * @brief   Greatest common divisor of a and b, with cofactors such that a * x + b * y = gcd(a, b).
+ *          |x| <= |b| / (2 gcd) and |y| <= |a| / (2 gcd) except in degenerate cases.
+ * 
+ * @param a 
+ * @param b 
+ * @param x Output.
+ * @param y Output.
+ * @return bigint 
+ */
+bigint extended_gcd(const bigint& a, const bigint& b, bigint& x, bigint& y);
+
+/**
+ * @brief Inverse of a modulo modulus.
+ * 
+ * @param a 
+ * @param modulus Must be positive, throws a domain_error otherwise.
+ * @return bigint Value in [0, modulus). Throws a domain_error if a and modulus are not coprime.
+ */
+bigint mod_inverse(const bigint& a, const bigint& modulus);
+
+/**
+ * @brief   Integer square root of n, the largest r such that r^2 <= n. Computed by Newton iteration with a precision
+ *          that doubles at each step, which costs about one division of the full size.
+ * 
+ * @param n Must not be negative, throws a domain_error otherwise.
+ * @return bigint 
+ */
+bigint isqrt(const bigint& n);
+
+/**
+ * @brief   Integer k-th root of n, the largest r such that r^k <= |n|, with the sign of n. Computed by Newton iteration
+ *          started from the root of the most significant half of the digits.
+ * 
+ * @param n Must not be negative when k is even, throws a domain_error otherwise.
+ * @param k Must not be 0, throws a domain_error otherwise.
+ * @return bigint 
+ */
+bigint iroot(const bigint& n, const uint64_t& k);
+
+/**
+ * @brief   Returns whether n is the square of an integer. Most non-squares are rejected from their residues modulo
+ *          256 and 2^48 - 1, without computing any root.
+ * 
+ * @param n 
+ * @return bool 
+ */
+bool is_perfect_square(const bigint& n);
+
+/**
+ * @brief   Product of all the factors, 1 if there are none. Computed as a balanced product tree, so that operands of
+ *          each product have about the same size and reach the fast multiplication tiers. The products of each level
+ *          of the tree are spread across threads (see set_bigint_thread_count).
+ * 
+ * @param factors 
+ * @return bigint 
+ */
+bigint product(const vector<bigint>& factors);
+
+/**
+ * @brief Sum of all the terms, 0 if there are none. Slices of the terms are summed in parallel.
+ * 
+ * @param terms 
+ * @return bigint 
+ */
+bigint sum(const vector<bigint>& terms);
+
+/**
+ * @brief n!, computed as a product tree of the odd parts of 1...n packed by limbs, and a final shift.
+ * 
+ * @param n 
+ * @return bigint 
+ */
+bigint factorial(const uint64_t& n);
+
+/**
+ * @brief n choose k, 0 if k > n. Numerator and denominator are product trees, divided exactly once.
+ * 
+ * @param n 
+ * @param k 
+ * @return bigint 
+ */
+bigint binomial(const uint64_t& n, const uint64_t& k);
+
+/**
+ * @brief   Read-only view on a bigint serialized by serialize, which reads the limbs where they are (in a memory mapped
+ *          file for instance) instead of copying them. The viewed bytes must outlive the view.
+ * 
+ */
+class bigint_view {
+
+public:
+    /**
+     * @brief   Construct a view on the serialized bigint at data. Only its header is read, the checksum is checked by
+     *          verify. Throws an invalid_argument if the header is not valid or if the limbs do not fit in size bytes.
+     * 
+     * @param data Should be 8 bytes aligned for limbs to be usable, which is the case at the start of a mapping.
+     * @param size Number of bytes readable at data.
+     */
+    bigint_view(const void* data, const uint64_t& size);
+
+    /**
+     * @brief Returns the number of limbs of the value.
+     * 
+     * @return uint64_t 
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief Returns the sign of the value, 1 or -1.
+     * 
+     * @return int8_t 
+     */
+    int8_t sign() const;
+
+    /**
+     * @brief Returns limb index of the absolute value, least significant first.
+     * 
+     * @param index 
+     * @return uint64_t 
+     */
+    uint64_t limb(const uint64_t& index) const;
+
+    /**
+     * @brief   Returns the limbs in place, least significant first. Only available on little endian machines with
+     *          data 8 bytes aligned, returns nullptr otherwise.
+     * 
+     * @return const uint64_t* 
+     */
+    const uint64_t* limbs() const;
+
+    /**
+     * @brief Returns the number of bytes of the serialized bigint, header included.
+     * 
+     * @return uint64_t 
+     */
+    uint64_t byte_size() const;
+
+    /**
+     * @brief Returns whether the serialized bigint carries a checksum.
+     * 
+     * @return bool 
+     */
+    bool has_checksum() const;
+
+    /**
+     * @brief Checks the limbs against the checksum, in one pass over them. Always true without a checksum.
+     * 
+     * @return bool 
+     */
+    bool verify() const;
+
+    /**
+     * @brief Copies the viewed value to a bigint.
+     * 
+     * @return bigint 
+     */
+    bigint to_bigint() const;
+
+
+private:
+    const unsigned char* limb_bytes;
+    uint64_t limb_count;
+    int8_t value_sign;
+    bool checksummed;
+    uint64_t checksum;
+};
+
+/**
+ * @brief Returns the number of bytes serialize writes for value.
+ * 
+ * @param value 
+ * @return uint64_t 
+ */
+uint64_t serialized_size(const bigint& value);
+
+/**
+ * @brief   Writes value in the binary format of bigint_view: a 24 bytes header (format version, sign, limb count and
+ *          optional checksum) followed by the limbs in little endian order.
+ * 
+ * @param value 
+ * @param out serialized_size(value) bytes.
+ * @param with_checksum Whether to compute a checksum of the limbs, which costs one extra pass over them.
+ */
+void serialize(const bigint& value, unsigned char* out, const bool& with_checksum = true);
+
+/**
+ * @brief Writes value to a binary stream, in the same format. The limbs are written straight from the bigint.
+ * 
+ * @param value 
+ * @param os Should be opened in binary mode.
+ * @param with_checksum 
+ */
+void serialize(const bigint& value, ostream& os, const bool& with_checksum = true);
+
+/**
+ * @brief   Reads a bigint written by serialize. Throws an invalid_argument if the data is not a valid serialized bigint,
+ *          is truncated or does not match its checksum.
+ * 
+ * @param data 
+ * @param size Number of bytes readable at data.
+ * @return bigint 
+ */
+bigint deserialize(const unsigned char* data, const uint64_t& size);
+
+/**
+ * @brief Reads a bigint written by serialize from a binary stream, the limbs straight into the bigint. Same errors.
+ * 
+ * @param is Should be opened in binary mode.
+ * @return bigint 
+ */
+bigint deserialize(istream& is);
+
+
+/**
+ * @brief   Unsigned integer of exactly Bits bits (a multiple of 64), for the sizes where a bigint's storage and size
+ *          checks cost more than the arithmetic itself. The limbs live inside the object, every loop is unrolled at
+ *          compile time, and everything but the conversions is constexpr.
+ *          Operators wrap around modulo 2^Bits like builtin unsigned integers. The checked_ methods throw an
+ *          overflow_error instead, and the overflowing_ ones report it.
+ * 
+ */
+template<uint64_t Bits>
+class fixed_bigint {
+    static_assert(Bits > 0 and Bits % 64 == 0, "fixed_bigint width must be a positive multiple of 64 bits.");
+
+public:
+    /**
+     * @brief Number of limbs.
+     * 
+     */
+    static constexpr uint64_t LIMBS = Bits / 64;
+
+    /**
+     * @brief Construct a new fixed_bigint object of value 0.
+     * 
+     */
+    constexpr fixed_bigint();
+
+    /**
+     * @brief Construct a new fixed_bigint object from a single limb.
+     * 
+     * @param initial_value 
+     */
+    constexpr fixed_bigint(const uint64_t& initial_value);
+
+    /**
+     * @brief Construct a new fixed_bigint object from a bigint, copying its limbs.
+     * 
+     * @param initial_value Must be non-negative and fit in Bits bits, throws an out_of_range otherwise.
+     */
+    explicit fixed_bigint(const bigint& initial_value);
+
+    /**
+     * @brief Returns the Bits least significant bits of value, in two's complement for negative values.
+     * 
+     * @param value 
+     * @return fixed_bigint 
+     */
+    static fixed_bigint truncate(const bigint& value);
+
+    /**
+     * @brief Returns the value as a bigint, copying its limbs.
+     * 
+     * @return bigint 
+     */
+    bigint to_bigint() const;
+
+    /**
+     * @brief Returns the number in the given base. See bigint::to_string.
+     * 
+     * @param base 
+     * @return string 
+     */
+    string to_string(const uint64_t& base = 10) const;
+
+    /**
+     * @brief Returns limb index, least significant first.
+     * 
+     * @param index Less than LIMBS.
+     * @return uint64_t 
+     */
+    constexpr uint64_t limb(const uint64_t& index) const;
+
+    /**
+     * @brief Wrapping arithmetic, modulo 2^Bits.
+     * 
+     * @param second_int 
+     * @return fixed_bigint 
+     */
+    constexpr fixed_bigint operator+(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint operator-(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint operator*(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint& operator+=(const fixed_bigint& second_int);
+    constexpr fixed_bigint& operator-=(const fixed_bigint& second_int);
+    constexpr fixed_bigint& operator*=(const fixed_bigint& second_int);
+
+    /**
+     * @brief Bitwise operators.
+     * 
+     * @param second_int 
+     * @return fixed_bigint 
+     */
+    constexpr fixed_bigint operator&(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint operator|(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint operator^(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint operator~() const;
+
+    /**
+     * @brief Checked arithmetic: throws an overflow_error if the result does not fit in Bits bits (or is negative).
+     * 
+     * @param second_int 
+     * @return fixed_bigint 
+     */
+    constexpr fixed_bigint checked_add(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint checked_sub(const fixed_bigint& second_int) const;
+    constexpr fixed_bigint checked_mul(const fixed_bigint& second_int) const;
+
+    /**
+     * @brief Wrapping arithmetic that also reports overflow: sets overflow to true if the exact result did not fit.
+     * 
+     * @param second_int 
+     * @param overflow Output.
+     * @return fixed_bigint 
+     */
+    constexpr fixed_bigint overflowing_add(const fixed_bigint& second_int, bool& overflow) const;
+    constexpr fixed_bigint overflowing_sub(const fixed_bigint& second_int, bool& overflow) const;
+    constexpr fixed_bigint overflowing_mul(const fixed_bigint& second_int, bool& overflow) const;
+
+    /**
+     * @brief Returns 1 if caller is greater, 0 if it is equal, -1 else.
+     * 
+     * @param second_int 
+     * @return int8_t 
+     */
+    constexpr int8_t compare(const fixed_bigint& second_int) const;
+
+    /**
+     * @brief Compares the numerical values of the caller and second_int.
+     * 
+     * @param second_int 
+     * @return true 
+     * @return false 
+     */
+    constexpr bool operator<(const fixed_bigint& second_int) const;
+    constexpr bool operator>(const fixed_bigint& second_int) const;
+    constexpr bool operator==(const fixed_bigint& second_int) const;
+    constexpr bool operator<=(const fixed_bigint& second_int) const;
+    constexpr bool operator>=(const fixed_bigint& second_int) const;
+    constexpr bool operator!=(const fixed_bigint& second_int) const;
+
+    /**
+     * @brief Outputs the number like a bigint would.
+     * 
+     * @param os 
+     * @param number 
+     * @return ostream& 
+     */
+    template<uint64_t OtherBits>
+    friend ostream& operator<<(ostream& os, const fixed_bigint<OtherBits>& number);
+
+
+private:
+    /**
+     * @brief Limbs of the value, least significant first.
+     * 
+     */
+    uint64_t values[LIMBS];
+
+    /**
+     * @brief Computes result = a + b, unrolled. Returns the carry.
+     * 
+     */
+    template<size_t... I>
+    static constexpr uint64_t add_limbs(fixed_bigint& result, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>);
+
+    /**
+     * @brief Computes result = a - b, unrolled. Returns the borrow.
+     * 
+     */
+    template<size_t... I>
+    static constexpr uint64_t sub_limbs(fixed_bigint& result, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>);
+
+    /**
+     * @brief   Adds a * b_limb to product, starting at limb Row, unrolled. When Truncated, limbs past LIMBS are dropped,
+     *          otherwise product must hold 2 * LIMBS limbs and gets the final carry.
+     * 
+     */
+    template<size_t Row, bool Truncated, size_t... J>
+    static constexpr void mul_row(uint64_t* product, const fixed_bigint& a, const uint64_t& b_limb, index_sequence<J...>);
+
+    /**
+     * @brief Computes the LIMBS least significant limbs of a * b, unrolled.
+     * 
+     */
+    template<size_t... I>
+    static constexpr void mul_limbs(fixed_bigint& result, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>);
+
+    /**
+     * @brief Computes the full 2 * LIMBS limbs product of a * b, unrolled.
+     * 
+     */
+    template<size_t... I>
+    static constexpr void mul_limbs_full(uint64_t* product, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>);
+
+    /**
+     * @brief Applies a bitwise operation limb by limb, unrolled.
+     * 
+     */
+    template<typename Operation, size_t... I>
+    static constexpr fixed_bigint bitwise(const fixed_bigint& a, const fixed_bigint& b, const Operation& operation, index_sequence<I...>);
+
+    /**
+     * @brief Compares a and b from their most significant limbs, unrolled.
+     * 
+     */
+    template<size_t... I>
+    static constexpr int8_t compare_limbs(const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>);
+};
+
+
+/**
+ * @brief   bigint literal, such as 123456789012345678901234567890_big or 0xFFFFFFFFFFFFFFFFFFFFFFFF_big. The digits are
+ *          parsed at compile time, following the rules of builtin integer literals (0x, 0b and 0 prefixes, ' separators),
+ *          so creating the bigint only copies its limbs. Invalid literals, like 1.5_big, do not compile.
+ * 
+ * @tparam Digits Characters of the literal.
+ * @return bigint 
+ */
+template<char... Digits>
+bigint operator""_big();
+
+
+
+
+
+
+
+
+//  ----------------------------------------MEMORY RESOURCES----------------------------------------
+
+/**
+ * @brief Per-thread storage for the current bigint memory resource.
+ * 
+ * @return pmr::memory_resource*& 
+ */
+static pmr::memory_resource*& current_bigint_resource() {
+    thread_local pmr::memory_resource* resource = pmr::new_delete_resource();
+    return resource;
+}
+
+static pmr::memory_resource* bigint_memory_resource() {
+    return current_bigint_resource();
+}
+
+bigint_resource_scope::bigint_resource_scope(pmr::memory_resource* resource) : previous(current_bigint_resource()) {
+    current_bigint_resource() = resource;
+}
+
+bigint_resource_scope::~bigint_resource_scope() {
+    current_bigint_resource() = previous;
+}
+
+bigint_arena::bigint_arena(const size_t& block_size, pmr::memory_resource* upstream_resource)
+    : current_block(0), offset(0), used(0), default_block_size(block_size), upstream(upstream_resource) {}
+
+bigint_arena::~bigint_arena() {
+    for (block& b : blocks) {
+        upstream->deallocate(b.memory, b.size, alignof(max_align_t));
+    }
+}
+
+void bigint_arena::reset() {
+    current_block = 0;
+    offset = 0;
+    used = 0;
+}
+
+size_t bigint_arena::bytes_used() const {
+    return used;
+}
+
+void* bigint_arena::do_allocate(size_t bytes, size_t alignment) {
+    //  Try the current block, then the following ones (left over from before a reset), then get a new one.
+    for (; current_block < blocks.size(); current_block++, offset = 0) {
+        block& b = blocks[current_block];
+        size_t aligned = (offset + alignment - 1) / alignment * alignment;
+        if (aligned + bytes <= b.size) {
+            offset = aligned + bytes;
+            used += bytes;
+            return b.memory + aligned;
+        }
+    }
+
+    size_t size = max(default_block_size, bytes + alignment);
+    block new_block = {(char*) upstream->allocate(size, alignof(max_align_t)), size};
+    blocks.push_back(new_block);
+    current_block = blocks.size() - 1;
+
+    size_t aligned = (size_t) ((alignment - (uintptr_t) new_block.memory % alignment) % alignment);
+    offset = aligned + bytes;
+    used += bytes;
+    return new_block.memory + aligned;
+}
+
+void bigint_arena::do_deallocate(void*, size_t, size_t) {
+    //  Memory is only reclaimed by reset().
+}
+
+bool bigint_arena::do_is_equal(const pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------THREADS----------------------------------------
+
+/*  Parallel algorithms share a single pool of worker threads, started the first time they are needed. Work is
+    handed out through parallel_for, whose caller takes part in the work, and then only waits for the calls that other
+    threads have already started. A parallel_for nested in the body of an other one therefore only ever waits on
+    threads that are running its own calls. The waiting thread never runs unrelated tasks, which could otherwise
+    reuse per-thread state (scratch buffers, statistics) of the call it is in the middle of.
+*/
+
+/**
+ * @brief Worker threads and the queue of tasks they take their work from.
+ * 
+ */
+struct thread_pool {
+    mutex queue_lock;
+    condition_variable queue_signal;
+    deque<function<void()>> tasks;
+    vector<thread> workers;
+    uint64_t thread_count;
+    bool stopping;
+
+    thread_pool() : thread_count(max<uint64_t>(thread::hardware_concurrency(), 1)), stopping(false) {}
+
+    ~thread_pool() {
+        stop();
+    }
+
+    /**
+     * @brief Starts the missing workers, thread_count - 1 of them as the calling thread also works.
+     * 
+     */
+    void start() {
+        lock_guard<mutex> guard(queue_lock);
+        while (workers.size() + 1 < thread_count) {
+            workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    /**
+     * @brief Lets the workers finish the queued tasks, and joins them.
+     * 
+     */
+    void stop() {
+        {
+            lock_guard<mutex> guard(queue_lock);
+            stopping = true;
+        }
+        queue_signal.notify_all();
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+        stopping = false;
+    }
+
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> guard(queue_lock);
+            tasks.push_back(std::move(task));
+        }
+        queue_signal.notify_one();
+    }
+
+    /**
+     * @brief Body of the worker threads.
+     * 
+     */
+    void work() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> guard(queue_lock);
+                queue_signal.wait(guard, [this]() { return stopping or !tasks.empty(); });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+
+/**
+ * @brief The pool shared by all parallel algorithms.
+ * 
+ * @return thread_pool& 
+ */
+static thread_pool& bigint_thread_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+
+/**
+ * @brief   Calls body(0) to body(count - 1), spread across the pool's threads and the calling thread. Returns once all
+ *          calls are done, and rethrows the first exception one of them threw, if any.
+ *          Runs serially when the calling thread allocates from an other resource than the default heap, as bigints
+ *          built by the workers would have to share it and memory resources are not thread-safe in general.
+ * 
+ * @param count 
+ * @param body 
+ */
+static void parallel_for(const uint64_t& count, const function<void(uint64_t)>& body) {
+    thread_pool& pool = bigint_thread_pool();
+    uint64_t helpers = min(pool.thread_count, count);
+    helpers = helpers > 0 ? helpers - 1 : 0;
+
+    if (helpers == 0 or bigint_memory_resource() != pmr::new_delete_resource()) {
+        for (uint64_t i = 0; i < count; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    /*  Shared with the helpers, which can still be queued when the loop is over: they then find no index left and
+        return without touching body.
+    */
+    struct loop_state {
+        atomic<uint64_t> next;
+        uint64_t done;
+        mutex lock;
+        condition_variable all_done;
+        exception_ptr error;
+    };
+    shared_ptr<loop_state> state = make_shared<loop_state>();
+    state->next = 0;
+    state->done = 0;
+
+    const function<void(uint64_t)>* loop_body = &body;
+    auto work = [state, loop_body, count]() {
+        for (uint64_t i = state->next++; i < count; i = state->next++) {
+            exception_ptr error;
+            try {
+                (*loop_body)(i);
+            }
+            catch (...) {
+                error = current_exception();
+            }
+
+            lock_guard<mutex> guard(state->lock);
+            if (error and !state->error) {
+                state->error = error;
+            }
+            if (++state->done == count) {
+                state->all_done.notify_all();
+            }
+        }
+    };
+
+    pool.start();
+    for (uint64_t i = 0; i < helpers; i++) {
+        pool.submit(work);
+    }
+    work();
+
+    //  Every index has been taken: the ones not done yet are running on other threads.
+    unique_lock<mutex> guard(state->lock);
+    state->all_done.wait(guard, [&]() { return state->done == count; });
+    if (state->error) {
+        rethrow_exception(state->error);
+    }
+}
+
+
+void set_bigint_thread_count(const uint64_t& count) {
+    thread_pool& pool = bigint_thread_pool();
+    pool.stop();
+    pool.thread_count = count > 0 ? count : max<uint64_t>(thread::hardware_concurrency(), 1);
+}
+
+uint64_t bigint_thread_count() {
+    return bigint_thread_pool().thread_count;
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------STATISTICS----------------------------------------
+
+/*  Counters are only compiled in when BIGINT_STATS is defined. Instrumented code goes through the BIGINT_STATS_...
+    macros, which expand to nothing otherwise, so that the default build does not pay for a single increment.
+    Global counters are relaxed atomics. Allocations and copies are first counted per thread, and attributed to the
+    operations running on that thread when they end.
+*/
+
+#if defined(BIGINT_STATS)
+
+static const uint64_t STATS_ADD = 0;
+static const uint64_t STATS_MULTIPLY = 1;
+static const uint64_t STATS_DIVIDE = 2;
+static const uint64_t STATS_TO_STRING = 3;
+static const uint64_t STATS_FROM_STRING = 4;
+static const uint64_t STATS_COPY = 5;
+static const uint64_t STATS_OPERATION_COUNT = 6;
+
+static const char* const STATS_OPERATION_NAMES[STATS_OPERATION_COUNT] = {"add", "multiply", "divide", "to_string", "from_string", "copy"};
+
+static const uint64_t STATS_SCHOOLBOOK = 0;
+static const uint64_t STATS_KARATSUBA = 1;
+static const uint64_t STATS_TOOM3 = 2;
+static const uint64_t STATS_NTT = 3;
+static const uint64_t STATS_UNBALANCED = 4;
+static const uint64_t STATS_TIER_COUNT = 5;
+
+
+/**
+ * @brief Counters shared by all threads.
+ * 
+ */
+struct stats_counters {
+    atomic<uint64_t> calls[STATS_OPERATION_COUNT];
+    atomic<uint64_t> limbs[STATS_OPERATION_COUNT];
+    atomic<uint64_t> allocations[STATS_OPERATION_COUNT];
+    atomic<uint64_t> bytes_copied[STATS_OPERATION_COUNT];
+    atomic<uint64_t> tiers[STATS_TIER_COUNT];
+    function<void(const char*, const uint64_t&)> timer;
+};
+
+
+/**
+ * @brief The global counters. Static storage, so they start at 0.
+ * 
+ * @return stats_counters& 
+ */
+static stats_counters& bigint_stats_counters() {
+    static stats_counters counters;
+    return counters;
+}
+
+
+/**
+ * @brief Allocations and copies made by the calling thread since it started.
+ * 
+ */
+struct thread_stats {
+    uint64_t allocations;
+    uint64_t bytes_copied;
+};
+
+static thread_stats& current_thread_stats() {
+    thread_local thread_stats stats = {0, 0};
+    return stats;
+}
+
+
+/**
+ * @brief Counts an operation for as long as it lives, and times it if a timer is set.
+ * 
+ */
+struct stats_scope {
+    uint64_t operation;
+    thread_stats start_stats;
+    bool timed;
+    chrono::steady_clock::time_point start_time;
+
+    stats_scope(const uint64_t& counted_operation, const uint64_t& limbs) : operation(counted_operation), start_stats(current_thread_stats()) {
+        stats_counters& counters = bigint_stats_counters();
+        counters.calls[operation].fetch_add(1, memory_order_relaxed);
+        counters.limbs[operation].fetch_add(limbs, memory_order_relaxed);
+        timed = (bool) counters.timer;
+        if (timed) {
+            start_time = chrono::steady_clock::now();
+        }
+    }
+
+    ~stats_scope() {
+        stats_counters& counters = bigint_stats_counters();
+        const thread_stats& stats = current_thread_stats();
+        counters.allocations[operation].fetch_add(stats.allocations - start_stats.allocations, memory_order_relaxed);
+        counters.bytes_copied[operation].fetch_add(stats.bytes_copied - start_stats.bytes_copied, memory_order_relaxed);
+        if (timed) {
+            uint64_t nanoseconds = (uint64_t) chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time).count();
+            counters.timer(STATS_OPERATION_NAMES[operation], nanoseconds);
+        }
+    }
+
+    stats_scope(const stats_scope&) = delete;
+    stats_scope& operator=(const stats_scope&) = delete;
+};
+
+#define BIGINT_STATS_SCOPE(operation, limb_count) stats_scope bigint_stats_scope_object(operation, limb_count)
+#define BIGINT_STATS_LIMBS(operation, limb_count) bigint_stats_counters().limbs[operation].fetch_add(limb_count, memory_order_relaxed)
+#define BIGINT_STATS_TIER(tier) bigint_stats_counters().tiers[tier].fetch_add(1, memory_order_relaxed)
+#define BIGINT_STATS_ALLOCATION() current_thread_stats().allocations++
+#define BIGINT_STATS_COPY(limb_count) current_thread_stats().bytes_copied += (limb_count) * sizeof(uint64_t)
+
+#else
+
+#define BIGINT_STATS_SCOPE(operation, limb_count)
+#define BIGINT_STATS_LIMBS(operation, limb_count)
+#define BIGINT_STATS_TIER(tier)
+#define BIGINT_STATS_ALLOCATION()
+#define BIGINT_STATS_COPY(limb_count)
+
+#endif
+
+
+bigint_stats bigint_stats_snapshot() {
+    bigint_stats snapshot = {};
+#if defined(BIGINT_STATS)
+    stats_counters& counters = bigint_stats_counters();
+    bigint_operation_stats* operations[STATS_OPERATION_COUNT] = {
+        &snapshot.add, &snapshot.multiply, &snapshot.divide, &snapshot.to_string, &snapshot.from_string, &snapshot.copy
+    };
+    for (uint64_t i = 0; i < STATS_OPERATION_COUNT; i++) {
+        operations[i]->calls = counters.calls[i].load(memory_order_relaxed);
+        operations[i]->limbs = counters.limbs[i].load(memory_order_relaxed);
+        operations[i]->allocations = counters.allocations[i].load(memory_order_relaxed);
+        operations[i]->bytes_copied = counters.bytes_copied[i].load(memory_order_relaxed);
+    }
+    snapshot.schoolbook_products = counters.tiers[STATS_SCHOOLBOOK].load(memory_order_relaxed);
+    snapshot.karatsuba_products = counters.tiers[STATS_KARATSUBA].load(memory_order_relaxed);
+    snapshot.toom3_products = counters.tiers[STATS_TOOM3].load(memory_order_relaxed);
+    snapshot.ntt_products = counters.tiers[STATS_NTT].load(memory_order_relaxed);
+    snapshot.unbalanced_products = counters.tiers[STATS_UNBALANCED].load(memory_order_relaxed);
+#endif
+    return snapshot;
+}
+
+void reset_bigint_stats() {
+#if defined(BIGINT_STATS)
+    stats_counters& counters = bigint_stats_counters();
+    for (uint64_t i = 0; i < STATS_OPERATION_COUNT; i++) {
+        counters.calls[i].store(0, memory_order_relaxed);
+        counters.limbs[i].store(0, memory_order_relaxed);
+        counters.allocations[i].store(0, memory_order_relaxed);
+        counters.bytes_copied[i].store(0, memory_order_relaxed);
+    }
+    for (uint64_t i = 0; i < STATS_TIER_COUNT; i++) {
+        counters.tiers[i].store(0, memory_order_relaxed);
+    }
+#endif
+}
+
+void set_bigint_stats_timer(const function<void(const char*, const uint64_t&)>& timer) {
+#if defined(BIGINT_STATS)
+    bigint_stats_counters().timer = timer;
+#else
+    (void) timer;
+#endif
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------LIMB STORAGE----------------------------------------
+
+limb_vector::limb_vector() : limbs(inline_limbs), length(0), allocated(INLINE_CAPACITY), resource(bigint_memory_resource()) {}
+
+limb_vector::limb_vector(const uint64_t& size, const uint64_t& value) : limb_vector() {
+    assign(size, value);
+}
+
+limb_vector::limb_vector(const limb_vector& source) : limb_vector() {
+    assign(source.begin(), source.end());
+}
+
+limb_vector::limb_vector(limb_vector&& source) noexcept : limb_vector() {
+    resource = source.resource;
+    *this = std::move(source);
+}
+
+limb_vector::~limb_vector() {
+    if (is_heap()) {
+        resource->deallocate(limbs, allocated * sizeof(uint64_t), alignof(uint64_t));
+    }
+}
+
+limb_vector& limb_vector::operator=(const limb_vector& source) {
+    if (&source != this) {
+        assign(source.begin(), source.end());
+    }
+    return *this;
+}
+
+limb_vector& limb_vector::operator=(limb_vector&& source) {
+    if (&source == this) {
+        return *this;
+    }
+
+    if (source.is_heap() and *resource == *source.resource) {
+        //  Heap storage changes hands, nothing is copied.
+        if (is_heap()) {
+            resource->deallocate(limbs, allocated * sizeof(uint64_t), alignof(uint64_t));
+        }
+        limbs = source.limbs;
+        length = source.length;
+        allocated = source.allocated;
+        source.limbs = source.inline_limbs;
+        source.allocated = INLINE_CAPACITY;
+    }
+    else {
+        //  Inline limbs cannot be taken over, but there are only a few of them. Storage from an other resource
+        //  cannot be taken over either, as it may not live as long as the caller.
+        assign(source.begin(), source.end());
+    }
+    source.length = 0;
+    return *this;
+}
+
+bool limb_vector::is_heap() const {
+    return limbs != inline_limbs;
+}
+
+void limb_vector::reallocate(const uint64_t& new_capacity) {
+    uint64_t* new_limbs = inline_limbs;
+    if (new_capacity > INLINE_CAPACITY) {
+        new_limbs = (uint64_t*) resource->allocate(new_capacity * sizeof(uint64_t), alignof(uint64_t));
+        BIGINT_STATS_ALLOCATION();
+    }
+    if (new_limbs != limbs) {
+        copy(limbs, limbs + length, new_limbs);
+        BIGINT_STATS_COPY(length);
+        if (is_heap()) {
+            resource->deallocate(limbs, allocated * sizeof(uint64_t), alignof(uint64_t));
+        }
+    }
+    limbs = new_limbs;
+    allocated = max(new_capacity, INLINE_CAPACITY);
+}
+
+uint64_t limb_vector::size() const {
+    return length;
+}
+
+uint64_t limb_vector::capacity() const {
+    return allocated;
+}
+
+bool limb_vector::empty() const {
+    return length == 0;
+}
+
+uint64_t* limb_vector::data() {
+    return limbs;
+}
+
+const uint64_t* limb_vector::data() const {
+    return limbs;
+}
+
+uint64_t* limb_vector::begin() {
+    return limbs;
+}
+
+const uint64_t* limb_vector::begin() const {
+    return limbs;
+}
+
+uint64_t* limb_vector::end() {
+    return limbs + length;
+}
+
+const uint64_t* limb_vector::end() const {
+    return limbs + length;
+}
+
+uint64_t& limb_vector::operator[](const uint64_t& index) {
+    return limbs[index];
+}
+
+const uint64_t& limb_vector::operator[](const uint64_t& index) const {
+    return limbs[index];
+}
+
+uint64_t& limb_vector::back() {
+    return limbs[length - 1];
+}
+
+const uint64_t& limb_vector::back() const {
+    return limbs[length - 1];
+}
+
+void limb_vector::reserve(const uint64_t& new_capacity) {
+    if (new_capacity > allocated) {
+        //  Geometric growth keeps push_back amortized constant time.
+        reallocate(max(new_capacity, 2 * allocated));
+    }
+}
+
+void limb_vector::resize(const uint64_t& new_size, const uint64_t& value) {
+    reserve(new_size);
+    if (new_size > length) {
+        fill(limbs + length, limbs + new_size, value);
+    }
+    length = new_size;
+}
+
+void limb_vector::assign(const uint64_t& size, const uint64_t& value) {
+    length = 0;
+    resize(size, value);
+}
+
+void limb_vector::assign(const uint64_t* first, const uint64_t* last) {
+    uint64_t size = (uint64_t) (last - first);
+    if (size > allocated) {
+        length = 0;
+        reserve(size);
+    }
+    copy(first, last, limbs);
+    BIGINT_STATS_COPY(size);
+    length = size;
+}
+
+void limb_vector::push_back(const uint64_t& value) {
+    reserve(length + 1);
+    limbs[length++] = value;
+}
+
+void limb_vector::pop_back() {
+    length--;
+}
+
+void limb_vector::clear() {
+    length = 0;
+}
+
+bool limb_vector::operator==(const limb_vector& other) const {
+    return length == other.length and equal(limbs, limbs + length, other.limbs);
+}
+
+bool limb_vector::operator!=(const limb_vector& other) const {
+    return not (*this == other);
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------STATIC FUNCTIONS----------------------------------------
+
+/**
+ * @brief Performs the a + b addition while checking for overflow. Carry is set to 1 if overflow occurs, 0 else.
+ * 
+ * @param a 
+ * @param b 
+ * @param carry 
+ * @return uint64_t 
+ */
+static uint64_t add_check_overflow(const uint64_t& a, const uint64_t& b, uint64_t& carry) {
+    uint64_t result = a + b;
+    carry = result < a ? 1 : 0;
+    return result;
+}
+
+
+/**
+ * @brief Returns the value of a digit character in bases up to 36 (letters of either case above 9), 36 if it is not one.
+ * 
+ * @param c character to read
+ */
+static uint64_t digit_value(const char& c) {
+    if (c >= '0' and c <= '9') {
+        return (uint64_t) (c - '0');
+    }
+    if (c >= 'a' and c <= 'z') {
+        return (uint64_t) (c - 'a') + 10;
+    }
+    if (c >= 'A' and c <= 'Z') {
+        return (uint64_t) (c - 'A') + 10;
+    }
+    return 36;
+}
+
+
+/**
+ * @brief   Compare function for uint64_t since I couldn't find the original one.
+ *          Returns -1 if v1 is smaller, 0 if equal, 1 else.
+ * 
+ * @param v1 
+ * @param v2 
+ * @return int 
+ */
+static int compare_64(const uint64_t& v1, const uint64_t& v2) {
+    if (v1 < v2) {
+        return -1;
+    }
+    if (v1 > v2) {
+        return 1;
+    }
+    return 0;
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------SIMD KERNELS----------------------------------------
+
+/*  x86-64 versions of the linear kernels (addition, subtraction and comparison of limb arrays).
+    Short operands go through adc / sbb chains, which every x86-64 processor has. Long ones use AVX2 (4 limbs) or
+    AVX-512 (8 limbs) carry-lookahead: all lanes are added at once, each lane tells whether it generates a carry
+    (its sum wrapped around) or would propagate an incoming one (its sum is all ones), and the carries between
+    lanes are then resolved by a single addition on those two bit masks:
+        carries into lanes = ((generate << 1 | carry in) + propagate) xor propagate
+    The instruction set is picked once at startup, from what the processor reports through CPUID.
+    Defining BIGINT_NO_SIMD before including bigint.hpp keeps the portable kernels only.
+*/
+
+#if defined(BIGINT_X86_64)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BIGINT_TARGET(features) __attribute__((target(features)))
+#else
+#define BIGINT_TARGET(features)
+#endif
+
+static const uint64_t SIMD_NONE = 0;
+static const uint64_t SIMD_AVX2 = 1;
+static const uint64_t SIMD_AVX512 = 2;
+
+
+/**
+ * @brief Returns the best vector instruction set that both the processor and the operating system support.
+ * 
+ * @return uint64_t SIMD_NONE, SIMD_AVX2 or SIMD_AVX512.
+ */
+static uint64_t detect_simd_level() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    }
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    __cpuid(info, 1);
+    //  The operating system must save the vector registers (OSXSAVE, then XCR0) for them to be usable.
+    bool avx = (info[2] & (1 << 27)) != 0 and (info[2] & (1 << 28)) != 0;
+    if (avx and max_leaf >= 7) {
+        uint64_t enabled_states = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        if ((enabled_states & 0xE6) == 0xE6 and (info[1] & (1 << 16)) != 0) {
+            return SIMD_AVX512;
+        }
+        if ((enabled_states & 0x6) == 0x6 and (info[1] & (1 << 5)) != 0) {
+            return SIMD_AVX2;
+        }
+    }
+#endif
+    return SIMD_NONE;
+}
+
+
+/**
+ * @brief   Vector instruction set used by the kernels, detected at startup. Can be lowered at runtime (to SIMD_NONE
+ *          or SIMD_AVX2), to compare kernels for instance.
+ * 
+ */
+static uint64_t SIMD_LEVEL = detect_simd_level();
+
+/**
+ * @brief   Operand size (in limbs) from which additions and subtractions use the vector kernels instead of adc / sbb.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t SIMD_ADD_THRESHOLD = 8;
+
+/**
+ * @brief Operand size (in limbs) from which comparisons use the vector kernels. Can be tuned at runtime.
+ * 
+ */
+static uint64_t SIMD_CMP_THRESHOLD = 8;
+
+
+/**
+ * @brief Computes result = a + b + carry with an adc chain. Returns the carry.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @param carry 0 or 1.
+ * @return uint64_t 
+ */
+static uint64_t limbs_add_n_adc(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size, const uint64_t& carry) {
+    unsigned char carry_flag = (unsigned char) carry;
+    unsigned long long sum;
+    for (uint64_t i = 0; i < size; i++) {
+        carry_flag = _addcarry_u64(carry_flag, a[i], b[i], &sum);
+        result[i] = sum;
+    }
+    return carry_flag;
+}
+
+
+/**
+ * @brief Computes result = a - b - borrow with an sbb chain. Returns the borrow.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @param borrow 0 or 1.
+ * @return uint64_t 
+ */
+static uint64_t limbs_sub_n_sbb(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size, const uint64_t& borrow) {
+    unsigned char borrow_flag = (unsigned char) borrow;
+    unsigned long long difference;
+    for (uint64_t i = 0; i < size; i++) {
+        borrow_flag = _subborrow_u64(borrow_flag, a[i], b[i], &difference);
+        result[i] = difference;
+    }
+    return borrow_flag;
+}
+
+
+/**
+ * @brief Computes result = a + b with AVX2 carry-lookahead, 4 limbs at a time. Returns the carry.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return uint64_t 
+ */
+BIGINT_TARGET("avx2")
+static uint64_t limbs_add_n_avx2(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+    const __m256i sign_bits = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+    uint64_t carry = 0, i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+        __m256i sum = _mm256_add_epi64(x, y);
+
+        //  AVX2 only compares signed integers: flipping the sign bits makes it an unsigned sum < x.
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign_bits), _mm256_xor_si256(sum, sign_bits));
+        __m256i propagate = _mm256_cmpeq_epi64(sum, ones);
+        uint64_t generate_mask = (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(generate));
+        uint64_t propagate_mask = (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(propagate));
+        uint64_t carries = (((generate_mask << 1) | carry) + propagate_mask) ^ propagate_mask;
+        carry = carries >> 4;
+
+        //  Lanes receiving a carry become -1, and subtracting them adds the carry.
+        __m256i carry_lanes = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x((int64_t) carries), lane_bits), lane_bits);
+        _mm256_storeu_si256((__m256i*) (result + i), _mm256_sub_epi64(sum, carry_lanes));
+    }
+    return limbs_add_n_adc(result + i, a + i, b + i, size - i, carry);
+}
+
+
+/**
+ * @brief Computes result = a - b with AVX2 borrow-lookahead, 4 limbs at a time. Returns the borrow.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return uint64_t 
+ */
+BIGINT_TARGET("avx2")
+static uint64_t limbs_sub_n_avx2(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+    const __m256i sign_bits = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i zeros = _mm256_setzero_si256();
+    const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+    uint64_t borrow = 0, i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+        __m256i difference = _mm256_sub_epi64(x, y);
+
+        //  A lane generates a borrow when y > x, and propagates one when its difference is 0.
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign_bits), _mm256_xor_si256(x, sign_bits));
+        __m256i propagate = _mm256_cmpeq_epi64(difference, zeros);
+        uint64_t generate_mask = (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(generate));
+        uint64_t propagate_mask = (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(propagate));
+        uint64_t borrows = (((generate_mask << 1) | borrow) + propagate_mask) ^ propagate_mask;
+        borrow = borrows >> 4;
+
+        __m256i borrow_lanes = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x((int64_t) borrows), lane_bits), lane_bits);
+        _mm256_storeu_si256((__m256i*) (result + i), _mm256_add_epi64(difference, borrow_lanes));
+    }
+    return limbs_sub_n_sbb(result + i, a + i, b + i, size - i, borrow);
+}
+
+
+/**
+ * @brief Compares two arrays of the same size with AVX2, 4 limbs at a time. Returns -1 if a is smaller, 0 if equal, 1 else.
+ * 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return int 
+ */
+BIGINT_TARGET("avx2")
+static int limbs_cmp_avx2(const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+    uint64_t i = size;
+    for (; i >= 4; i -= 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (a + i - 4));
+        __m256i y = _mm256_loadu_si256((const __m256i*) (b + i - 4));
+        if (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, y))) != 0xF) {
+            break;
+        }
+    }
+
+    //  At most 4 limbs left before the first difference.
+    for (; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Computes result = a + b with AVX-512 carry-lookahead, 8 limbs at a time. Returns the carry.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return uint64_t 
+ */
+BIGINT_TARGET("avx512f")
+static uint64_t limbs_add_n_avx512(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    uint64_t carry = 0, i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m512i x = _mm512_loadu_si512((const void*) (a + i));
+        __m512i y = _mm512_loadu_si512((const void*) (b + i));
+        __m512i sum = _mm512_add_epi64(x, y);
+        uint64_t generate_mask = _mm512_cmplt_epu64_mask(sum, x);
+        uint64_t propagate_mask = _mm512_cmpeq_epu64_mask(sum, ones);
+        uint64_t carries = (((generate_mask << 1) | carry) + propagate_mask) ^ propagate_mask;
+        carry = carries >> 8;
+        _mm512_storeu_si512((void*) (result + i), _mm512_mask_sub_epi64(sum, (__mmask8) carries, sum, ones));
+    }
+    return limbs_add_n_adc(result + i, a + i, b + i, size - i, carry);
+}
+
+
+/**
+ * @brief Computes result = a - b with AVX-512 borrow-lookahead, 8 limbs at a time. Returns the borrow.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return uint64_t 
+ */
+BIGINT_TARGET("avx512f")
+static uint64_t limbs_sub_n_avx512(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    uint64_t borrow = 0, i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m512i x = _mm512_loadu_si512((const void*) (a + i));
+        __m512i y = _mm512_loadu_si512((const void*) (b + i));
+        __m512i difference = _mm512_sub_epi64(x, y);
+        uint64_t generate_mask = _mm512_cmplt_epu64_mask(x, y);
+        uint64_t propagate_mask = _mm512_cmpeq_epu64_mask(difference, _mm512_setzero_si512());
+        uint64_t borrows = (((generate_mask << 1) | borrow) + propagate_mask) ^ propagate_mask;
+        borrow = borrows >> 8;
+        _mm512_storeu_si512((void*) (result + i), _mm512_mask_add_epi64(difference, (__mmask8) borrows, difference, ones));
+    }
+    return limbs_sub_n_sbb(result + i, a + i, b + i, size - i, borrow);
+}
+
+
+/**
+ * @brief Compares two arrays of the same size with AVX-512, 8 limbs at a time. Returns -1 if a is smaller, 0 if equal, 1 else.
+ * 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return int 
+ */
+BIGINT_TARGET("avx512f")
+static int limbs_cmp_avx512(const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+    uint64_t i = size;
+    for (; i >= 8; i -= 8) {
+        __m512i x = _mm512_loadu_si512((const void*) (a + i - 8));
+        __m512i y = _mm512_loadu_si512((const void*) (b + i - 8));
+        if (_mm512_cmpneq_epu64_mask(x, y) != 0) {
+            break;
+        }
+    }
+
+    //  At most 8 limbs left before the first difference.
+    for (; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+#endif
+
+
+
+
+
+
+
+
+//  ----------------------------------------LIMB KERNELS----------------------------------------
+
+/*  The functions below work directly on arrays of limbs (64 bits fields, least significant first).
+    They only deal with absolute values: signs are handled by the bigint methods calling them.
+    Unless stated otherwise, result arrays must be large enough and must not overlap the inputs
+    (in-place operations where result == a are fine for the linear kernels).
+*/
+
+/**
+ * @brief   Operand size (in limbs) from which multiplication switches from schoolbook to Karatsuba.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t KARATSUBA_THRESHOLD = 32;
+
+/**
+ * @brief   Operand size (in limbs) from which multiplication switches from Karatsuba to Toom-3.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t TOOM3_THRESHOLD = 160;
+
+/**
+ * @brief   Operand size (in limbs) from which squaring switches from schoolbook to Karatsuba.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t KARATSUBA_SQUARE_THRESHOLD = 48;
+
+/**
+ * @brief   Operand size (in limbs) from which squaring switches from Karatsuba to Toom-3.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t TOOM3_SQUARE_THRESHOLD = 400;
+
+
+/**
+ * @brief   Computes the full 128 bits product of a and b. Returns the 64 least significant bits and stores the
+ *          64 most significant ones in high.
+ *          Uses the compiler's 128 bits integers (a single mul instruction on x86-64) or _umul128 when available,
+ *          and falls back to blocs of 32 bits otherwise.
+ * 
+ * @param a 
+ * @param b 
+ * @param high 
+ * @return uint64_t 
+ */
+static uint64_t mul_64_64(const uint64_t& a, const uint64_t& b, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128) a * b;
+    high = (uint64_t) (product >> 64);
+    return (uint64_t) product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, &high);
+#else
+    uint64_t a_low = a & 0xFFFFFFFFULL, a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFFULL, b_high = b >> 32;
+
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high;
+
+    //  Cannot overflow: (2^32 - 1)^2 + 2 * (2^32 - 1) == 2^64 - 1.
+    uint64_t cross = (low_low >> 32) + (high_low & 0xFFFFFFFFULL) + low_high;
+
+    high = a_high * b_high + (high_low >> 32) + (cross >> 32);
+    return (cross << 32) | (low_low & 0xFFFFFFFFULL);
+#endif
+}
+
+
+/**
+ * @brief Returns the number of limbs of a once the 0s at the front are ignored. Returns 0 if a is 0.
+ * 
+ * @param a 
+ * @param size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_normalized_size(const uint64_t* a, uint64_t size) {
+    while (size > 0 and a[size - 1] == 0) {
+        size--;
+    }
+    return size;
+}
+
+
+/**
+ * @brief Compares two arrays of the same size. Returns -1 if a is smaller, 0 if equal, 1 else.
+ * 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return int 
+ */
+static int limbs_cmp(const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+#if defined(BIGINT_X86_64)
+    if (size >= SIMD_CMP_THRESHOLD) {
+        if (SIMD_LEVEL >= SIMD_AVX512) {
+            return limbs_cmp_avx512(a, b, size);
+        }
+        if (SIMD_LEVEL >= SIMD_AVX2) {
+            return limbs_cmp_avx2(a, b, size);
+        }
+    }
+#endif
+    for (uint64_t i = size; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Computes result = a + b where a and b have the same size. Returns the carry.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_add_n(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+#if defined(BIGINT_X86_64)
+    if (size >= SIMD_ADD_THRESHOLD) {
+        if (SIMD_LEVEL >= SIMD_AVX512) {
+            return limbs_add_n_avx512(result, a, b, size);
+        }
+        if (SIMD_LEVEL >= SIMD_AVX2) {
+            return limbs_add_n_avx2(result, a, b, size);
+        }
+    }
+    return limbs_add_n_adc(result, a, b, size, 0);
+#else
+    uint64_t carry = 0, carry_a, carry_b;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t sum = add_check_overflow(a[i], b[i], carry_a);
+        result[i] = add_check_overflow(sum, carry, carry_b);
+        carry = carry_a | carry_b;
+    }
+    return carry;
+#endif
+}
+
+
+/**
+ * @brief Computes result = a + b where b is a single limb. Returns the carry.
+ * 
+ * @param result 
+ * @param a 
+ * @param size Size of a.
+ * @param b 
+ * @return uint64_t 
+ */
+static uint64_t limbs_add_1(uint64_t* result, const uint64_t* a, const uint64_t& size, const uint64_t& b) {
+    uint64_t carry = b;
+    for (uint64_t i = 0; i < size; i++) {
+        result[i] = add_check_overflow(a[i], carry, carry);
+    }
+    return carry;
+}
+
+
+/**
+ * @brief Computes result = a + b, a_size >= b_size. result must hold a_size limbs. Returns the carry.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_add(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size) {
+    uint64_t carry = limbs_add_n(result, a, b, b_size);
+    return limbs_add_1(result + b_size, a + b_size, a_size - b_size, carry);
+}
+
+
+/**
+ * @brief Computes result = a - b where a and b have the same size. Returns the borrow.
+ * 
+ * @param result 
+ * @param a 
+ * @param b 
+ * @param size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_sub_n(uint64_t* result, const uint64_t* a, const uint64_t* b, const uint64_t& size) {
+#if defined(BIGINT_X86_64)
+    if (size >= SIMD_ADD_THRESHOLD) {
+        if (SIMD_LEVEL >= SIMD_AVX512) {
+            return limbs_sub_n_avx512(result, a, b, size);
+        }
+        if (SIMD_LEVEL >= SIMD_AVX2) {
+            return limbs_sub_n_avx2(result, a, b, size);
+        }
+    }
+    return limbs_sub_n_sbb(result, a, b, size, 0);
+#else
+    uint64_t borrow = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t difference = a[i] - b[i];
+        uint64_t borrow_a = difference > a[i];
+        result[i] = difference - borrow;
+        borrow = borrow_a | (result[i] > difference);
+    }
+    return borrow;
+#endif
+}
+
+
+/**
+ * @brief Computes result = a - b where b is a single limb. Returns the borrow.
+ * 
+ * @param result 
+ * @param a 
+ * @param size Size of a.
+ * @param b 
+ * @return uint64_t 
+ */
+static uint64_t limbs_sub_1(uint64_t* result, const uint64_t* a, const uint64_t& size, const uint64_t& b) {
+    uint64_t borrow = b;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t difference = a[i] - borrow;
+        borrow = difference > a[i];
+        result[i] = difference;
+    }
+    return borrow;
+}
+
+
+/**
+ * @brief Computes result = a - b, a_size >= b_size. result must hold a_size limbs. Returns the borrow.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_sub(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size) {
+    uint64_t borrow = limbs_sub_n(result, a, b, b_size);
+    return limbs_sub_1(result + b_size, a + b_size, a_size - b_size, borrow);
+}
+
+
+/**
+ * @brief   Computes result = 2^(64 * size) - a, the two's complement of a. Returns 1 unless a is 0.
+ *          result can be a.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_neg(uint64_t* result, const uint64_t* a, const uint64_t& size) {
+    uint64_t i = 0;
+    while (i < size and a[i] == 0) {
+        result[i++] = 0ULL;
+    }
+    if (i == size) {
+        return 0;
+    }
+    result[i] = 0 - a[i];
+    for (i++; i < size; i++) {
+        result[i] = ~a[i];
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Computes result = a * b where b is a single limb. Returns the most significant limb of the product.
+ * 
+ * @param result 
+ * @param a 
+ * @param size Size of a.
+ * @param b 
+ * @return uint64_t 
+ */
+static uint64_t limbs_mul_1(uint64_t* result, const uint64_t* a, const uint64_t& size, const uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    //  (2^64 - 1)^2 + 2^64 - 1 < 2^128: the carry always fits in the accumulator.
+    unsigned __int128 accumulator = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        accumulator += (unsigned __int128) a[i] * b;
+        result[i] = (uint64_t) accumulator;
+        accumulator >>= 64;
+    }
+    return (uint64_t) accumulator;
+#else
+    uint64_t carry = 0, high, overflow;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t low = mul_64_64(a[i], b, high);
+        result[i] = add_check_overflow(low, carry, overflow);
+        carry = high + overflow;
+    }
+    return carry;
+#endif
+}
+
+
+/**
+ * @brief Computes result += a * b where b is a single limb. Returns the limb carried out of result.
+ * 
+ * @param result 
+ * @param a 
+ * @param size Size of a. result must hold at least as many limbs.
+ * @param b 
+ * @return uint64_t 
+ */
+static uint64_t limbs_addmul_1(uint64_t* result, const uint64_t* a, const uint64_t& size, const uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    //  (2^64 - 1)^2 + 2 * (2^64 - 1) == 2^128 - 1: the carry always fits in the accumulator.
+    unsigned __int128 accumulator = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        accumulator += (unsigned __int128) a[i] * b + result[i];
+        result[i] = (uint64_t) accumulator;
+        accumulator >>= 64;
+    }
+    return (uint64_t) accumulator;
+#else
+    uint64_t carry = 0, high, overflow_carry, overflow_result;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t low = mul_64_64(a[i], b, high);
+        low = add_check_overflow(low, carry, overflow_carry);
+        result[i] = add_check_overflow(result[i], low, overflow_result);
+        //  high <= 2^64 - 2 so this cannot overflow.
+        carry = high + overflow_carry + overflow_result;
+    }
+    return carry;
+#endif
+}
+
+
+/**
+ * @brief   Shifts a to the left by bits (0 < bits < 64) and stores it in result. Returns the bits shifted out.
+ *          Works from the most significant limb down, so result can be a or start above it.
+ *          Each limb of result only depends on two limbs of a, which lets compilers vectorize the loop.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ * @param bits 
+ * @return uint64_t 
+ */
+static uint64_t limbs_lshift(uint64_t* result, const uint64_t* a, const uint64_t& size, const unsigned& bits) {
+    uint64_t out = a[size - 1] >> (64 - bits);
+    for (uint64_t i = size - 1; i > 0; i--) {
+        result[i] = (a[i] << bits) | (a[i - 1] >> (64 - bits));
+    }
+    result[0] = a[0] << bits;
+    return out;
+}
+
+
+/**
+ * @brief   Shifts a to the right by bits (0 < bits < 64) and stores it in result. Returns the bits shifted out,
+ *          left aligned. Works from the least significant limb up, so result can be a or start below it.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ * @param bits 
+ * @return uint64_t 
+ */
+static uint64_t limbs_rshift(uint64_t* result, const uint64_t* a, const uint64_t& size, const unsigned& bits) {
+    uint64_t out = a[0] << (64 - bits);
+    for (uint64_t i = 0; i + 1 < size; i++) {
+        result[i] = (a[i] >> bits) | (a[i + 1] << (64 - bits));
+    }
+    result[size - 1] = a[size - 1] >> bits;
+    return out;
+}
+
+
+/**
+ * @brief Computes result -= a * b where b is a single limb. Returns the limb borrowed from past result.
+ * 
+ * @param result 
+ * @param a 
+ * @param size Size of a. result must hold at least as many limbs.
+ * @param b 
+ * @return uint64_t 
+ */
+static uint64_t limbs_submul_1(uint64_t* result, const uint64_t* a, const uint64_t& size, const uint64_t& b) {
+    uint64_t borrow = 0, high, overflow;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t low = mul_64_64(a[i], b, high);
+        low = add_check_overflow(low, borrow, overflow);
+        uint64_t value = result[i];
+        result[i] = value - low;
+        //  high <= 2^64 - 2 so this cannot overflow.
+        borrow = high + overflow + (result[i] > value);
+    }
+    return borrow;
+}
+
+
+/**
+ * @brief Returns the number of 0 bits in front of the most significant 1 of value. value must not be 0.
+ * 
+ * @param value 
+ * @return unsigned 
+ */
+static unsigned count_leading_zeros_64(uint64_t value) {
+#if defined(__GNUC__)
+    return (unsigned) __builtin_clzll(value);
+#else
+    unsigned count = 0;
+    while ((value & 0x8000000000000000ULL) == 0) {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+
+/**
+ * @brief   Divides the 128 bits number high * 2^64 + low by d. high must be smaller than d so that the quotient fits in 64 bits.
+ *          Slow, only used to set up faster divisions (see reciprocal_64).
+ * 
+ * @param high 
+ * @param low 
+ * @param d 
+ * @param remainder 
+ * @return uint64_t Quotient.
+ */
+static uint64_t div_128_64(const uint64_t& high, const uint64_t& low, const uint64_t& d, uint64_t& remainder) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 number = ((unsigned __int128) high << 64) | low;
+    remainder = (uint64_t) (number % d);
+    return (uint64_t) (number / d);
+#else
+    //  Long division by blocs of 32 bits of a normalized divisor (Hacker's Delight, divlu).
+    const uint64_t base = 0x100000000ULL;
+    unsigned shift = count_leading_zeros_64(d);
+    uint64_t d_norm = d << shift;
+    uint64_t d_high = d_norm >> 32, d_low = d_norm & 0xFFFFFFFFULL;
+    uint64_t number_high = shift == 0 ? high : (high << shift) | (low >> (64 - shift));
+    uint64_t number_low = low << shift;
+    uint64_t low_1 = number_low >> 32, low_0 = number_low & 0xFFFFFFFFULL;
+
+    uint64_t q1 = number_high / d_high, rhat = number_high - q1 * d_high;
+    while (q1 >= base or q1 * d_low > base * rhat + low_1) {
+        q1--;
+        rhat += d_high;
+        if (rhat >= base) {
+            break;
+        }
+    }
+
+    uint64_t middle = number_high * base + low_1 - q1 * d_norm;
+    uint64_t q0 = middle / d_high;
+    rhat = middle - q0 * d_high;
+    while (q0 >= base or q0 * d_low > base * rhat + low_0) {
+        q0--;
+        rhat += d_high;
+        if (rhat >= base) {
+            break;
+        }
+    }
+
+    remainder = (middle * base + low_0 - q0 * d_norm) >> shift;
+    return q1 * base + q0;
+#endif
+}
+
+
+/**
+ * @brief   Computes floor((2^128 - 1) / d) - 2^64 for a normalized d (most significant bit set).
+ *          Lets divisions by d be performed with products only (see div_2by1_preinv).
+ * 
+ * @param d 
+ * @return uint64_t 
+ */
+static uint64_t reciprocal_64(const uint64_t& d) {
+    uint64_t remainder;
+    return div_128_64(~d, ~0ULL, d, remainder);
+}
+
+
+/**
+ * @brief   Divides high * 2^64 + low by a normalized d using its precomputed reciprocal (Moller and Granlund).
+ *          high must be smaller than d.
+ * 
+ * @param high 
+ * @param low 
+ * @param d 
+ * @param reciprocal reciprocal_64(d).
+ * @param remainder 
+ * @return uint64_t Quotient.
+ */
+static uint64_t div_2by1_preinv(const uint64_t& high, const uint64_t& low, const uint64_t& d, const uint64_t& reciprocal, uint64_t& remainder) {
+    uint64_t quotient_high;
+    uint64_t quotient_low = mul_64_64(reciprocal, high, quotient_high);
+    quotient_low += low;
+    quotient_high += high + (quotient_low < low) + 1;
+
+    uint64_t rest = low - quotient_high * d;
+    if (rest > quotient_low) {
+        quotient_high--;
+        rest += d;
+    }
+    if (rest >= d) {
+        quotient_high++;
+        rest -= d;
+    }
+    remainder = rest;
+    return quotient_high;
+}
+
+
+/**
+ * @brief Computes quotient = a / d where d is a single non-zero limb. Returns the remainder. quotient can be a.
+ * 
+ * @param quotient 
+ * @param a 
+ * @param size 
+ * @param d 
+ * @return uint64_t 
+ */
+static uint64_t limbs_divrem_1(uint64_t* quotient, const uint64_t* a, const uint64_t& size, const uint64_t& d) {
+    unsigned shift = count_leading_zeros_64(d);
+    uint64_t d_norm = d << shift;
+    uint64_t reciprocal = reciprocal_64(d_norm);
+    uint64_t remainder = 0;
+
+    if (shift == 0) {
+        for (uint64_t i = size; i > 0; i--) {
+            quotient[i - 1] = div_2by1_preinv(remainder, a[i - 1], d_norm, reciprocal, remainder);
+        }
+        return remainder;
+    }
+
+    //  Dividing a * 2^shift by d * 2^shift gives the same quotient, and the remainder times 2^shift.
+    remainder = a[size - 1] >> (64 - shift);
+    for (uint64_t i = size; i > 0; i--) {
+        uint64_t next = i > 1 ? a[i - 2] >> (64 - shift) : 0ULL;
+        quotient[i - 1] = div_2by1_preinv(remainder, (a[i - 1] << shift) | next, d_norm, reciprocal, remainder);
+    }
+    return remainder >> shift;
+}
+
+
+/**
+ * @brief Returns a mod d where d is a single non-zero limb. Same as limbs_divrem_1 without storing the quotient.
+ * 
+ * @param a 
+ * @param size 
+ * @param d 
+ * @return uint64_t 
+ */
+static uint64_t limbs_mod_1(const uint64_t* a, const uint64_t& size, const uint64_t& d) {
+    unsigned shift = count_leading_zeros_64(d);
+    uint64_t d_norm = d << shift;
+    uint64_t reciprocal = reciprocal_64(d_norm);
+    uint64_t remainder = shift == 0 ? 0ULL : a[size - 1] >> (64 - shift);
+
+    for (uint64_t i = size; i > 0; i--) {
+        uint64_t next = (shift != 0 and i > 1) ? a[i - 2] >> (64 - shift) : 0ULL;
+        div_2by1_preinv(remainder, (a[i - 1] << shift) | next, d_norm, reciprocal, remainder);
+    }
+    return remainder >> shift;
+}
+
+
+/**
+ * @brief   Divides a by 3 in place. Only gives a meaningful result if a is a multiple of 3.
+ *          Uses the inverse of 3 modulo 2^64 instead of actual divisions.
+ * 
+ * @param a 
+ * @param size 
+ */
+static void limbs_divexact_by3(uint64_t* a, const uint64_t& size) {
+    const uint64_t inverse_3 = 0xAAAAAAAAAAAAAAABULL;
+    uint64_t borrow = 0, high;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t value = a[i] - borrow;
+        uint64_t underflow = value > a[i];
+        uint64_t quotient = value * inverse_3;
+        a[i] = quotient;
+        mul_64_64(quotient, 3, high);
+        borrow = high + underflow;
+    }
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------MULTIPLICATION----------------------------------------
+
+/*  Multiplication is dispatched on operand sizes by limbs_mul:
+    - schoolbook below KARATSUBA_THRESHOLD limbs,
+    - Karatsuba (3 half-size products) below TOOM3_THRESHOLD limbs,
+    - Toom-3 (5 third-size products) below NTT_THRESHOLD limbs,
+    - number theoretic transforms above.
+    Very unbalanced operands are cut into chunks the size of the smaller one first, so that every
+    sub-product is balanced and can make use of the faster algorithms.
+    Squares (a and b being the same array) are dispatched to limbs_sqr, which has its own version of
+    each algorithm and its own thresholds. A square has half as many distinct cross products as a
+    general product, and its sub-products are squares too.
+    When parallel multiplication is enabled, the independent sub-products of Karatsuba and Toom-3, and the
+    transforms modulo each prime, are spread across threads from PARALLEL_MUL_THRESHOLD limbs on.
+    Karatsuba and Toom-3 need temporary limbs for their operand sums and intermediate products. The first level
+    allocates all of them at once (see limbs_mul_scratch_size), takes its own part from the front of the buffer
+    and hands the rest down to its sub-products, which do the same. Callers doing many products in a row can
+    pass a buffer of their own.
+*/
+
+static void limbs_mul(uint64_t* result, const uint64_t* a, uint64_t a_size, const uint64_t* b, uint64_t b_size, uint64_t* scratch = nullptr);
+static void limbs_sqr(uint64_t* result, const uint64_t* a, const uint64_t& size, uint64_t* scratch = nullptr);
+
+
+/**
+ * @brief   Operand size (in limbs) from which the sub-products of a product are computed in parallel, when parallel
+ *          multiplication is enabled. Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t PARALLEL_MUL_THRESHOLD = 3000;
+
+/**
+ * @brief Whether parallel multiplication is enabled. See set_bigint_parallel_multiplication.
+ * 
+ */
+static bool PARALLEL_MULTIPLICATION = false;
+
+
+void set_bigint_parallel_multiplication(const bool& enabled) {
+    PARALLEL_MULTIPLICATION = enabled;
+}
+
+bool bigint_parallel_multiplication() {
+    return PARALLEL_MULTIPLICATION;
+}
+
+
+/**
+ * @brief   Calls products(0, scratch) to products(count - 1, scratch), which compute independent sub-products of a
+ *          product whose operands have size limbs, one after the other. If parallel multiplication is enabled and size
+ *          is at least PARALLEL_MUL_THRESHOLD, they run in parallel instead and get a null scratch, so that each of
+ *          them allocates its own.
+ * 
+ * @param count 
+ * @param size 
+ * @param scratch 
+ * @param products 
+ */
+static void run_subproducts(const uint64_t& count, const uint64_t& size, uint64_t* scratch, const function<void(uint64_t, uint64_t*)>& products) {
+    if (PARALLEL_MULTIPLICATION and size >= PARALLEL_MUL_THRESHOLD) {
+        parallel_for(count, [&](uint64_t i) {
+            products(i, nullptr);
+        });
+        return;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        products(i, scratch);
+    }
+}
+
+
+/**
+ * @brief Schoolbook product. result must hold a_size + b_size limbs.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ */
+static void limbs_mul_basecase(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size) {
+    //  The first row initializes result, the following ones are accumulated on top of it.
+    result[a_size] = limbs_mul_1(result, a, a_size, b[0]);
+    for (uint64_t j = 1; j < b_size; j++) {
+        result[a_size + j] = limbs_addmul_1(result + j, a, a_size, b[j]);
+    }
+}
+
+
+/**
+ * @brief   Schoolbook square. result must hold 2 * size limbs.
+ *          Each cross product a[i] * a[j] with i < j is computed once and the sum is doubled, then the squares
+ *          of the limbs are added on the diagonal.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ */
+static void limbs_sqr_basecase(uint64_t* result, const uint64_t* a, const uint64_t& size) {
+    result[0] = 0ULL;
+    result[2 * size - 1] = 0ULL;
+    if (size > 1) {
+        //  Row i holds a[i] * a[i + 1 ... size - 1], at limb 2i + 1.
+        result[size] = limbs_mul_1(result + 1, a + 1, size - 1, a[0]);
+        for (uint64_t i = 1; i + 1 < size; i++) {
+            result[size + i] = limbs_addmul_1(result + 2 * i + 1, a + i + 1, size - i - 1, a[i]);
+        }
+        result[2 * size - 1] = limbs_lshift(result + 1, result + 1, 2 * size - 2, 1);
+    }
+
+    uint64_t carry = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t high;
+        uint64_t low = mul_64_64(a[i], a[i], high);
+        uint64_t diagonal[2] = {low, high};
+        uint64_t out = limbs_add_n(result + 2 * i, result + 2 * i, diagonal, 2);
+        out += limbs_add_1(result + 2 * i, result + 2 * i, 2, carry);
+        carry = out;
+    }
+}
+
+
+/**
+ * @brief Adds value to result at the given limb offset. The sum must fit in result_size limbs.
+ * 
+ * @param result 
+ * @param result_size 
+ * @param offset 
+ * @param value 
+ * @param value_size 
+ */
+static void limbs_add_at(uint64_t* result, const uint64_t& result_size, const uint64_t& offset, const uint64_t* value, uint64_t value_size) {
+    value_size = limbs_normalized_size(value, value_size);
+    if (value_size > 0) {
+        limbs_add(result + offset, result + offset, result_size - offset, value, value_size);
+    }
+}
+
+
+
+
+/**
+ * @brief   Karatsuba product, for a_size >= b_size > (a_size + 1) / 2. result must hold a_size + b_size limbs.
+ *          a * b = z2 * B^2k + (z1 - z2 - z0) * B^k + z0 with z1 = (a0 + a1) * (b0 + b1).
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @param scratch 4k + 4 limbs, followed by the scratch of a (k + 1) limbs product.
+ */
+static void limbs_mul_karatsuba(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size, uint64_t* scratch) {
+    uint64_t k = (a_size + 1) / 2;
+    uint64_t a1_size = a_size - k, b1_size = b_size - k;
+    uint64_t result_size = a_size + b_size;
+
+    uint64_t* a_sum = scratch;
+    uint64_t* b_sum = a_sum + k + 1;
+    uint64_t* middle = b_sum + k + 1;
+
+    a_sum[k] = limbs_add(a_sum, a, k, a + k, a1_size);
+    b_sum[k] = limbs_add(b_sum, b, k, b + k, b1_size);
+
+    //  z0 and z2 go straight to their final place since they do not overlap.
+    run_subproducts(3, b_size, middle + 2 * k + 2, [&](uint64_t i, uint64_t* product_scratch) {
+        if (i == 0) {
+            limbs_mul(result, a, k, b, k, product_scratch);
+        }
+        else if (i == 1) {
+            limbs_mul(result + 2 * k, a + k, a1_size, b + k, b1_size, product_scratch);
+        }
+        else {
+            limbs_mul(middle, a_sum, k + 1, b_sum, k + 1, product_scratch);
+        }
+    });
+
+    limbs_sub(middle, middle, 2 * k + 2, result, 2 * k);
+    limbs_sub(middle, middle, 2 * k + 2, result + 2 * k, a1_size + b1_size);
+
+    limbs_add_at(result, result_size, k, middle, min(2 * k + 2, result_size - k));
+}
+
+
+/**
+ * @brief   Karatsuba square. result must hold 2 * size limbs.
+ *          a^2 = z2 * B^2k + (z2 + z0 - (a0 - a1)^2) * B^k + z0, which only needs squares.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ * @param scratch 5k + 2 limbs, followed by the scratch of a k limbs square.
+ */
+static void limbs_sqr_karatsuba(uint64_t* result, const uint64_t* a, const uint64_t& size, uint64_t* scratch) {
+    uint64_t k = (size + 1) / 2;
+    uint64_t a1_size = size - k;
+    uint64_t result_size = 2 * size;
+
+    uint64_t* difference = scratch;
+    uint64_t* difference_square = difference + k;
+    uint64_t* middle = difference_square + 2 * k;
+
+    //  |a0 - a1|, a1 being padded with zeros up to k limbs.
+    bool a0_larger = limbs_normalized_size(a + a1_size, k - a1_size) > 0 or limbs_cmp(a, a + k, a1_size) >= 0;
+    if (a0_larger) {
+        limbs_sub(difference, a, k, a + k, a1_size);
+    }
+    else {
+        limbs_sub_n(difference, a + k, a, a1_size);
+        fill(difference + a1_size, difference + k, 0ULL);
+    }
+
+    //  z0 and z2 go straight to their final place since they do not overlap.
+    run_subproducts(3, size, middle + 2 * k + 2, [&](uint64_t i, uint64_t* product_scratch) {
+        if (i == 0) {
+            limbs_sqr(result, a, k, product_scratch);
+        }
+        else if (i == 1) {
+            limbs_sqr(result + 2 * k, a + k, a1_size, product_scratch);
+        }
+        else {
+            limbs_sqr(difference_square, difference, k, product_scratch);
+        }
+    });
+
+    middle[2 * k] = limbs_add(middle, result, 2 * k, result + 2 * k, 2 * a1_size);
+    middle[2 * k + 1] = 0ULL;
+    limbs_sub(middle, middle, 2 * k + 2, difference_square, 2 * k);
+
+    limbs_add_at(result, result_size, k, middle, min(2 * k + 2, result_size - k));
+}
+
+
+/*  Some of the intermediate values of Toom-3 products are negative. Each of them is kept as a magnitude, in a slice
+    of the scratch buffer large enough for any value it takes, and a separate sign.
+*/
+
+/**
+ * @brief   Computes a + b on signed values, a and result having size limbs and b b_size <= size limbs. Returns the sign
+ *          of the result, which must fit in size limbs. result can be a or b.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_negative 
+ * @param b 
+ * @param b_size 
+ * @param b_negative 
+ * @param size 
+ * @return bool 
+ */
+static bool toom_add(uint64_t* result, const uint64_t* a, const bool& a_negative, const uint64_t* b, const uint64_t& b_size,
+                     const bool& b_negative, const uint64_t& size) {
+    if (a_negative == b_negative) {
+        limbs_add(result, a, size, b, b_size);
+        return a_negative;
+    }
+
+    //  Magnitudes are subtracted, the result takes the sign of the largest one.
+    if (limbs_normalized_size(a + b_size, size - b_size) > 0 or limbs_cmp(a, b, b_size) >= 0) {
+        limbs_sub(result, a, size, b, b_size);
+        return a_negative;
+    }
+    limbs_sub_n(result, b, a, b_size);
+    fill(result + b_size, result + size, 0ULL);
+    return b_negative;
+}
+
+
+/**
+ * @brief Computes a - b on signed values, see toom_add.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_negative 
+ * @param b 
+ * @param b_size 
+ * @param b_negative 
+ * @param size 
+ * @return bool 
+ */
+static bool toom_sub(uint64_t* result, const uint64_t* a, const bool& a_negative, const uint64_t* b, const uint64_t& b_size,
+                     const bool& b_negative, const uint64_t& size) {
+    return toom_add(result, a, a_negative, b, b_size, !b_negative, size);
+}
+
+
+/**
+ * @brief   Evaluates a0 + a1 * x + a2 * x^2 in 1, -1 and -2, a0 and a1 being the first two blocks of k limbs of a and a2
+ *          the a2_size remaining ones. Each value is written to a slice of k + 1 limbs, which always fits its magnitude
+ *          (smaller than 7 * B^k). The signs of the values in -1 and -2 are stored in m1_negative and m2_negative.
+ * 
+ * @param p1 
+ * @param m1 
+ * @param m1_negative 
+ * @param m2 
+ * @param m2_negative 
+ * @param a 
+ * @param k 
+ * @param a2_size 
+ */
+static void toom3_evaluate(uint64_t* p1, uint64_t* m1, bool& m1_negative, uint64_t* m2, bool& m2_negative,
+                           const uint64_t* a, const uint64_t& k, const uint64_t& a2_size) {
+    const uint64_t* a1 = a + k;
+    const uint64_t* a2 = a + 2 * k;
+
+    //  a0 + a2, from which a(-1) = a0 + a2 - a1 and a(1) = a0 + a2 + a1.
+    p1[k] = limbs_add(p1, a, k, a2, a2_size);
+    m1_negative = toom_sub(m1, p1, false, a1, k, false, k + 1);
+    limbs_add(p1, p1, k + 1, a1, k);
+
+    //  a(-2) = 2 * (a(-1) + a2) - a0.
+    m2_negative = toom_add(m2, m1, m1_negative, a2, a2_size, false, k + 1);
+    limbs_lshift(m2, m2, k + 1, 1);
+    m2_negative = toom_sub(m2, m2, m2_negative, a, k, false, k + 1);
+}
+
+
+/**
+ * @brief   Interpolates the 5 values of a Toom-3 product using Bodrato's sequence and adds the middle coefficients
+ *          to result. r0 and r4, the values at 0 and infinity, must already be in place in result, which must be
+ *          0 everywhere else. r1, r2 and r3 are the values at 1, -1 and -2, in slices of 2k + 2 limbs, and are
+ *          overwritten.
+ * 
+ * @param result 
+ * @param result_size 
+ * @param k Size of the parts.
+ * @param r4_size 
+ * @param r1 
+ * @param r2 
+ * @param r2_negative 
+ * @param r3 
+ * @param r3_negative 
+ */
+static void toom3_interpolate(uint64_t* result, const uint64_t& result_size, const uint64_t& k, const uint64_t& r4_size,
+                              uint64_t* r1, uint64_t* r2, bool r2_negative, uint64_t* r3, bool r3_negative) {
+    uint64_t size = 2 * k + 2;
+    const uint64_t* r0 = result;
+    const uint64_t* r4 = result + 4 * k;
+    bool r1_negative = false;
+
+    //  All divisions are exact.
+    r3_negative = toom_sub(r3, r3, r3_negative, r1, size, r1_negative, size);
+    limbs_divexact_by3(r3, size);
+    r1_negative = toom_sub(r1, r1, r1_negative, r2, size, r2_negative, size);
+    limbs_rshift(r1, r1, size, 1);
+    r2_negative = toom_sub(r2, r2, r2_negative, r0, 2 * k, false, size);
+    r3_negative = toom_sub(r3, r2, r2_negative, r3, size, r3_negative, size);
+    limbs_rshift(r3, r3, size, 1);
+    r3_negative = toom_add(r3, r3, r3_negative, r4, r4_size, false, size);
+    r3_negative = toom_add(r3, r3, r3_negative, r4, r4_size, false, size);
+    r2_negative = toom_add(r2, r2, r2_negative, r1, size, r1_negative, size);
+    r2_negative = toom_sub(r2, r2, r2_negative, r4, r4_size, false, size);
+    toom_sub(r1, r1, r1_negative, r3, size, r3_negative, size);
+
+    //  Recomposition. The remaining coefficients are all positive.
+    limbs_add_at(result, result_size, k, r1, size);
+    limbs_add_at(result, result_size, 2 * k, r2, size);
+    limbs_add_at(result, result_size, 3 * k, r3, size);
+}
+
+
+/**
+ * @brief   Toom-3 product, for a_size >= b_size > 2 * ceil(a_size / 3). result must hold a_size + b_size limbs.
+ *          Both operands are split in 3 parts and evaluated in 0, 1, -1, -2 and infinity. The 5 products are
+ *          then interpolated using Bodrato's sequence.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @param scratch 12k + 12 limbs, followed by the scratch of a (k + 1) limbs product.
+ */
+static void limbs_mul_toom3(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size, uint64_t* scratch) {
+    uint64_t k = (a_size + 2) / 3;
+    uint64_t a2_size = a_size - 2 * k, b2_size = b_size - 2 * k;
+    uint64_t result_size = a_size + b_size;
+
+    //  Evaluation, into slices of k + 1 limbs.
+    uint64_t* a_p1 = scratch;
+    uint64_t* a_m1 = a_p1 + k + 1;
+    uint64_t* a_m2 = a_m1 + k + 1;
+    uint64_t* b_p1 = a_m2 + k + 1;
+    uint64_t* b_m1 = b_p1 + k + 1;
+    uint64_t* b_m2 = b_m1 + k + 1;
+    bool a_m1_negative, a_m2_negative, b_m1_negative, b_m2_negative;
+    toom3_evaluate(a_p1, a_m1, a_m1_negative, a_m2, a_m2_negative, a, k, a2_size);
+    toom3_evaluate(b_p1, b_m1, b_m1_negative, b_m2, b_m2_negative, b, k, b2_size);
+
+    //  Pointwise products. r0 and r4 go straight to their final place since they do not overlap.
+    uint64_t* r1 = b_m2 + k + 1;
+    uint64_t* r2 = r1 + 2 * k + 2;
+    uint64_t* r3 = r2 + 2 * k + 2;
+    fill(result + 2 * k, result + 4 * k, 0ULL);
+    run_subproducts(5, b_size, r3 + 2 * k + 2, [&](uint64_t i, uint64_t* product_scratch) {
+        if (i == 0) {
+            limbs_mul(result, a, k, b, k, product_scratch);
+        }
+        else if (i == 1) {
+            limbs_mul(result + 4 * k, a + 2 * k, a2_size, b + 2 * k, b2_size, product_scratch);
+        }
+        else if (i == 2) {
+            limbs_mul(r1, a_p1, k + 1, b_p1, k + 1, product_scratch);
+        }
+        else if (i == 3) {
+            limbs_mul(r2, a_m1, k + 1, b_m1, k + 1, product_scratch);
+        }
+        else {
+            limbs_mul(r3, a_m2, k + 1, b_m2, k + 1, product_scratch);
+        }
+    });
+
+    toom3_interpolate(result, result_size, k, a2_size + b2_size, r1, r2, a_m1_negative != b_m1_negative, r3, a_m2_negative != b_m2_negative);
+}
+
+
+/**
+ * @brief   Toom-3 square, for size > 2 * ceil(size / 3). result must hold 2 * size limbs.
+ *          Same as limbs_mul_toom3, with a single evaluation and 5 squares.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ * @param scratch 9k + 9 limbs, followed by the scratch of a (k + 1) limbs square.
+ */
+static void limbs_sqr_toom3(uint64_t* result, const uint64_t* a, const uint64_t& size, uint64_t* scratch) {
+    uint64_t k = (size + 2) / 3;
+    uint64_t a2_size = size - 2 * k;
+    uint64_t result_size = 2 * size;
+
+    //  Evaluation, into slices of k + 1 limbs.
+    uint64_t* a_p1 = scratch;
+    uint64_t* a_m1 = a_p1 + k + 1;
+    uint64_t* a_m2 = a_m1 + k + 1;
+    bool a_m1_negative, a_m2_negative;
+    toom3_evaluate(a_p1, a_m1, a_m1_negative, a_m2, a_m2_negative, a, k, a2_size);
+
+    //  Pointwise squares. r0 and r4 go straight to their final place since they do not overlap.
+    uint64_t* r1 = a_m2 + k + 1;
+    uint64_t* r2 = r1 + 2 * k + 2;
+    uint64_t* r3 = r2 + 2 * k + 2;
+    fill(result + 2 * k, result + 4 * k, 0ULL);
+    run_subproducts(5, size, r3 + 2 * k + 2, [&](uint64_t i, uint64_t* product_scratch) {
+        if (i == 0) {
+            limbs_sqr(result, a, k, product_scratch);
+        }
+        else if (i == 1) {
+            limbs_sqr(result + 4 * k, a + 2 * k, a2_size, product_scratch);
+        }
+        else if (i == 2) {
+            limbs_sqr(r1, a_p1, k + 1, product_scratch);
+        }
+        else if (i == 3) {
+            limbs_sqr(r2, a_m1, k + 1, product_scratch);
+        }
+        else {
+            limbs_sqr(r3, a_m2, k + 1, product_scratch);
+        }
+    });
+
+    toom3_interpolate(result, result_size, k, 2 * a2_size, r1, r2, false, r3, false);
+}
+
+
+/*  Above NTT_THRESHOLD limbs, products are computed as convolutions using number theoretic transforms
+    modulo three primes just under 2^62, in which 2^55-th roots of unity exist. Every coefficient of the
+    convolution is smaller than min(a_size, b_size) * 2^128 so it can be recovered exactly from its three
+    residues using the chinese remainder theorem, as long as operands are shorter than 2^55 limbs.
+    Modular products use Montgomery's reduction, which only needs 64 x 64 -> 128 bits products.
+*/
+
+/**
+ * @brief Constants needed to compute in Z/pZ for one of the primes used by the NTT.
+ * 
+ */
+struct ntt_prime {
+    uint64_t modulus;
+    uint64_t generator;
+    uint64_t max_log_size;
+    //  -modulus^-1 mod 2^64.
+    uint64_t inverse;
+    //  2^128 mod modulus, used to move values to Montgomery form.
+    uint64_t r2;
+};
+
+
+/**
+ * @brief Montgomery product: returns a * b / 2^64 mod p. a * b must be smaller than p * 2^64.
+ * 
+ * @param a 
+ * @param b 
+ * @param prime 
+ * @return uint64_t 
+ */
+static uint64_t ntt_mont_mul(const uint64_t& a, const uint64_t& b, const ntt_prime& prime) {
+    uint64_t high, reduction_high;
+    uint64_t low = mul_64_64(a, b, high);
+    uint64_t reduction = low * prime.inverse;
+    mul_64_64(reduction, prime.modulus, reduction_high);
+
+    //  low + the low half of reduction * modulus is always 0 mod 2^64, so it carries unless low is 0.
+    uint64_t result = high + reduction_high + (low != 0);
+    return result >= prime.modulus ? result - prime.modulus : result;
+}
+
+
+/**
+ * @brief Returns a + b mod p, for a and b smaller than p.
+ * 
+ * @param a 
+ * @param b 
+ * @param prime 
+ * @return uint64_t 
+ */
+static uint64_t ntt_add(const uint64_t& a, const uint64_t& b, const ntt_prime& prime) {
+    uint64_t result = a + b;
+    return result >= prime.modulus ? result - prime.modulus : result;
+}
+
+
+/**
+ * @brief Returns a - b mod p, for a and b smaller than p.
+ * 
+ * @param a 
+ * @param b 
+ * @param prime 
+ * @return uint64_t 
+ */
+static uint64_t ntt_sub(const uint64_t& a, const uint64_t& b, const ntt_prime& prime) {
+    return a >= b ? a - b : a + prime.modulus - b;
+}
+
+
+/**
+ * @brief Computes base^exp in Montgomery form. base must be in Montgomery form.
+ * 
+ * @param base 
+ * @param exp 
+ * @param prime 
+ * @return uint64_t 
+ */
+static uint64_t ntt_mont_pow(uint64_t base, uint64_t exp, const ntt_prime& prime) {
+    uint64_t result = ntt_mont_mul(1, prime.r2, prime);
+    while (exp > 0) {
+        if (exp & 1) {
+            result = ntt_mont_mul(result, base, prime);
+        }
+        base = ntt_mont_mul(base, base, prime);
+        exp >>= 1;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Computes the Montgomery constants of a prime.
+ * 
+ * @param modulus 
+ * @param generator A generator of the multiplicative group of Z/modulusZ.
+ * @param max_log_size The largest k such that 2^k divides modulus - 1.
+ * @return ntt_prime 
+ */
+static ntt_prime make_ntt_prime(const uint64_t& modulus, const uint64_t& generator, const uint64_t& max_log_size) {
+    ntt_prime prime;
+    prime.modulus = modulus;
+    prime.generator = generator;
+    prime.max_log_size = max_log_size;
+
+    //  Newton's iteration doubles the number of correct bits each time, modulus is its own inverse mod 2^3.
+    uint64_t inverse = modulus;
+    for (int i = 0; i < 5; i++) {
+        inverse *= 2 - modulus * inverse;
+    }
+    prime.inverse = 0 - inverse;
+
+    uint64_t r2 = 1;
+    for (int i = 0; i < 128; i++) {
+        r2 = r2 >= modulus - r2 ? r2 - (modulus - r2) : 2 * r2;
+    }
+    prime.r2 = r2;
+    return prime;
+}
+
+
+/**
+ * @brief The three NTT primes, largest first.
+ * 
+ */
+static const ntt_prime NTT_PRIMES[3] = {
+    make_ntt_prime(4179340454199820289ULL, 3, 57),  // 29 * 2^57 + 1
+    make_ntt_prime(2485986994308513793ULL, 5, 55),  // 69 * 2^55 + 1
+    make_ntt_prime(1945555039024054273ULL, 5, 56)   // 27 * 2^56 + 1
+};
+
+
+/**
+ * @brief   Operand size (in limbs) from which multiplication switches from Toom-3 to NTT.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t NTT_THRESHOLD = 6000;
+
+
+/**
+ * @brief   Fills roots so that roots[half + j] = w^j for every power of 2 half < size and j < half,
+ *          w being a primitive (2 * half)-th root of unity, or its inverse if inverse is set. Montgomery form.
+ * 
+ * @param roots 
+ * @param size Transform size, a power of 2.
+ * @param prime 
+ * @param inverse 
+ */
+static void ntt_fill_roots(scratch_vector& roots, const uint64_t& size, const ntt_prime& prime, const bool& inverse) {
+    roots.resize(max<uint64_t>(size, 2));
+    uint64_t generator = ntt_mont_mul(prime.generator, prime.r2, prime);
+    uint64_t one = ntt_mont_mul(1, prime.r2, prime);
+
+    for (uint64_t half = 1; half < size; half *= 2) {
+        uint64_t exp = (prime.modulus - 1) / (2 * half);
+        if (inverse) {
+            exp = prime.modulus - 1 - exp;
+        }
+        uint64_t w = ntt_mont_pow(generator, exp, prime);
+        roots[half] = one;
+        for (uint64_t j = 1; j < half; j++) {
+            roots[half + j] = ntt_mont_mul(roots[half + j - 1], w, prime);
+        }
+    }
+}
+
+
+/**
+ * @brief   In place forward transform (decimation in frequency). Leaves the result in bit-reversed order,
+ *          which is fine since it is only multiplied pointwise and fed to ntt_inverse.
+ * 
+ * @param a 
+ * @param size 
+ * @param roots 
+ * @param prime 
+ */
+static void ntt_forward(uint64_t* a, const uint64_t& size, const scratch_vector& roots, const ntt_prime& prime) {
+    for (uint64_t half = size / 2; half >= 1; half /= 2) {
+        for (uint64_t i = 0; i < size; i += 2 * half) {
+            for (uint64_t j = 0; j < half; j++) {
+                uint64_t u = a[i + j], v = a[i + j + half];
+                a[i + j] = ntt_add(u, v, prime);
+                a[i + j + half] = ntt_mont_mul(ntt_sub(u, v, prime), roots[half + j], prime);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief   In place inverse transform (decimation in time), taking bit-reversed input. The result is multiplied by size.
+ * 
+ * @param a 
+ * @param size 
+ * @param roots Inverse roots.
+ * @param prime 
+ */
+static void ntt_inverse(uint64_t* a, const uint64_t& size, const scratch_vector& roots, const ntt_prime& prime) {
+    for (uint64_t half = 1; half < size; half *= 2) {
+        for (uint64_t i = 0; i < size; i += 2 * half) {
+            for (uint64_t j = 0; j < half; j++) {
+                uint64_t u = a[i + j], v = ntt_mont_mul(a[i + j + half], roots[half + j], prime);
+                a[i + j] = ntt_add(u, v, prime);
+                a[i + j + half] = ntt_sub(u, v, prime);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief   Computes the cyclic convolution of a and b modulo one prime, in standard (not Montgomery) form.
+ *          size must be a power of 2 no smaller than a_size and b_size. Coefficients wrap around unless size is
+ *          at least a_size + b_size - 1.
+ * 
+ * @param residues Output, size values.
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @param size 
+ * @param prime 
+ */
+static void ntt_convolution(uint64_t* residues, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size,
+                            const uint64_t& size, const ntt_prime& prime) {
+    scratch_vector roots(bigint_memory_resource()), other(bigint_memory_resource());
+
+    //  Moving to Montgomery form also reduces limbs modulo the prime.
+    for (uint64_t i = 0; i < size; i++) {
+        residues[i] = i < a_size ? ntt_mont_mul(a[i], prime.r2, prime) : 0ULL;
+    }
+
+    ntt_fill_roots(roots, size, prime, false);
+    ntt_forward(residues, size, roots, prime);
+
+    if (a == b and a_size == b_size) {
+        //  Squares only need one forward transform.
+        for (uint64_t i = 0; i < size; i++) {
+            residues[i] = ntt_mont_mul(residues[i], residues[i], prime);
+        }
+    }
+    else {
+        other.assign(size, 0ULL);
+        for (uint64_t i = 0; i < b_size; i++) {
+            other[i] = ntt_mont_mul(b[i], prime.r2, prime);
+        }
+        ntt_forward(other.data(), size, roots, prime);
+        for (uint64_t i = 0; i < size; i++) {
+            residues[i] = ntt_mont_mul(residues[i], other[i], prime);
+        }
+    }
+
+    ntt_fill_roots(roots, size, prime, true);
+    ntt_inverse(residues, size, roots, prime);
+
+    //  A Montgomery product by the plain value 1 / size both leaves Montgomery form and cancels the size factor.
+    uint64_t size_inverse = 1;
+    for (uint64_t s = 1; s < size; s *= 2) {
+        size_inverse = size_inverse % 2 == 0 ? size_inverse / 2 : size_inverse / 2 + (prime.modulus + 1) / 2;
+    }
+    for (uint64_t i = 0; i < size; i++) {
+        residues[i] = ntt_mont_mul(residues[i], size_inverse, prime);
+    }
+}
+
+
+/**
+ * @brief Constants needed to recombine the residues of the three NTT primes. Values marked _mont are in Montgomery form.
+ * 
+ */
+struct ntt_crt_constants {
+    //  1 / p0 mod p1.
+    uint64_t p0_inverse_mont;
+    //  p0 mod p2.
+    uint64_t p0_mod_p2_mont;
+    //  1 / (p0 * p1) mod p2.
+    uint64_t p01_inverse_mont;
+    //  p0 * p1, least significant limb first.
+    uint64_t p01[2];
+};
+
+
+/**
+ * @brief Computes the inverse of a modulo a prime in Montgomery form, using Fermat's little theorem.
+ * 
+ * @param a Plain value.
+ * @param prime 
+ * @return uint64_t 
+ */
+static uint64_t ntt_mont_inverse(const uint64_t& a, const ntt_prime& prime) {
+    return ntt_mont_pow(ntt_mont_mul(a, prime.r2, prime), prime.modulus - 2, prime);
+}
+
+
+/**
+ * @brief Computes the constants used by ntt_crt.
+ * 
+ * @return ntt_crt_constants 
+ */
+static ntt_crt_constants make_ntt_crt_constants() {
+    const ntt_prime& p0 = NTT_PRIMES[0];
+    const ntt_prime& p1 = NTT_PRIMES[1];
+    const ntt_prime& p2 = NTT_PRIMES[2];
+
+    ntt_crt_constants constants;
+    constants.p0_inverse_mont = ntt_mont_inverse(p0.modulus, p1);
+    constants.p0_mod_p2_mont = ntt_mont_mul(p0.modulus, p2.r2, p2);
+    //  A Montgomery product of a plain value and a Montgomery form value is a plain value.
+    uint64_t p01_mod_p2 = ntt_mont_mul(p1.modulus, constants.p0_mod_p2_mont, p2);
+    constants.p01_inverse_mont = ntt_mont_inverse(p01_mod_p2, p2);
+    constants.p01[0] = mul_64_64(p0.modulus, p1.modulus, constants.p01[1]);
+    return constants;
+}
+
+
+/**
+ * @brief Computed once, at static initialization.
+ * 
+ */
+static const ntt_crt_constants NTT_CRT = make_ntt_crt_constants();
+
+
+/**
+ * @brief   Recovers a convolution coefficient (up to 3 limbs) from its residues modulo the three NTT primes.
+ *          Uses Garner's formulation of the chinese remainder theorem.
+ * 
+ * @param result 3 limbs.
+ * @param r0 
+ * @param r1 
+ * @param r2 
+ */
+static void ntt_crt(uint64_t* result, uint64_t r0, const uint64_t& r1, const uint64_t& r2) {
+    const ntt_prime& p0 = NTT_PRIMES[0];
+    const ntt_prime& p1 = NTT_PRIMES[1];
+    const ntt_prime& p2 = NTT_PRIMES[2];
+
+    //  x01 = r0 + p0 * t1 is the unique value modulo p0 * p1 matching r0 and r1.
+    uint64_t r0_mod_p1 = r0;
+    while (r0_mod_p1 >= p1.modulus) {
+        r0_mod_p1 -= p1.modulus;
+    }
+    uint64_t t1 = ntt_mont_mul(ntt_sub(r1, r0_mod_p1, p1), NTT_CRT.p0_inverse_mont, p1);
+
+    //  x = x01 + p0 * p1 * t2 also matches r2.
+    uint64_t r0_mod_p2 = r0;
+    while (r0_mod_p2 >= p2.modulus) {
+        r0_mod_p2 -= p2.modulus;
+    }
+    uint64_t x01_mod_p2 = ntt_add(r0_mod_p2, ntt_mont_mul(t1, NTT_CRT.p0_mod_p2_mont, p2), p2);
+    uint64_t t2 = ntt_mont_mul(ntt_sub(r2, x01_mod_p2, p2), NTT_CRT.p01_inverse_mont, p2);
+
+    uint64_t x01[2];
+    x01[0] = mul_64_64(p0.modulus, t1, x01[1]);
+    x01[1] += limbs_add_1(x01, x01, 1, r0);
+
+    result[2] = limbs_mul_1(result, NTT_CRT.p01, 2, t2);
+    limbs_add(result, result, 3, x01, 2);
+}
+
+
+/**
+ * @brief   NTT product. result must hold a_size + b_size limbs.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ */
+static void limbs_mul_ntt(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size) {
+    uint64_t result_size = a_size + b_size;
+    uint64_t size = 1;
+    while (size < result_size - 1) {
+        size *= 2;
+    }
+
+    //  When the product just misses a power of 2, the few top limbs of the longer operand are multiplied with schoolbook
+    //  rows so that the transforms are half as long. Newton's iteration for division gets such sizes at every level.
+    const uint64_t* longer = a_size >= b_size ? a : b;
+    const uint64_t* shorter = a_size >= b_size ? b : a;
+    uint64_t longer_size = max(a_size, b_size), shorter_size = min(a_size, b_size);
+    uint64_t excess = result_size - 1 - size / 2;
+    if (size >= 4 and excess <= 16 and excess < longer_size) {
+        uint64_t peeled = longer_size - excess;
+        limbs_mul_ntt(result, longer, peeled, shorter, shorter_size);
+        fill(result + peeled + shorter_size, result + result_size, 0ULL);
+        for (uint64_t i = peeled; i < longer_size; i++) {
+            result[i + shorter_size] = limbs_addmul_1(result + i, shorter, shorter_size, longer[i]);
+        }
+        return;
+    }
+
+    //  The three convolutions are independent.
+    scratch_vector residues(3 * size, bigint_memory_resource());
+    run_subproducts(3, b_size, nullptr, [&](uint64_t p, uint64_t*) {
+        ntt_convolution(residues.data() + p * size, a, a_size, b, b_size, size, NTT_PRIMES[p]);
+    });
+
+    //  Coefficients overlap each other by up to 2 limbs, which are carried to the next ones.
+    uint64_t carry[2] = {0ULL, 0ULL};
+    for (uint64_t i = 0; i < result_size; i++) {
+        uint64_t coefficient[3] = {0ULL, 0ULL, 0ULL};
+        if (i < result_size - 1) {
+            ntt_crt(coefficient, residues[i], residues[size + i], residues[2 * size + i]);
+        }
+        limbs_add(coefficient, coefficient, 3, carry, 2);
+        result[i] = coefficient[0];
+        carry[0] = coefficient[1];
+        carry[1] = coefficient[2];
+    }
+}
+
+
+/**
+ * @brief   Cyclic NTT product: stores a * b mod (B^size - 1) in the size limbs of result, for a power of 2 size no smaller
+ *          than a_size or b_size. Costs about as much as an NTT product whose result has size limbs, which is half of
+ *          the full product when only a few limbs of it are unknown (see limbs_div_newton_block).
+ *          A result of 0 may come out as B^size - 1.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @param size 
+ */
+static void limbs_mul_ntt_cyclic(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size,
+                                 const uint64_t& size) {
+    //  Coefficients beyond size wrap around in the convolution, and B^size = 1 wraps the carries around the same way.
+    scratch_vector residues(3 * size, bigint_memory_resource());
+    run_subproducts(3, min(a_size, b_size), nullptr, [&](uint64_t p, uint64_t*) {
+        ntt_convolution(residues.data() + p * size, a, a_size, b, b_size, size, NTT_PRIMES[p]);
+    });
+
+    uint64_t carry[2] = {0ULL, 0ULL};
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t coefficient[3];
+        ntt_crt(coefficient, residues[i], residues[size + i], residues[2 * size + i]);
+        limbs_add(coefficient, coefficient, 3, carry, 2);
+        result[i] = coefficient[0];
+        carry[0] = coefficient[1];
+        carry[1] = coefficient[2];
+    }
+    uint64_t wrapped = limbs_add(result, result, size, carry, min<uint64_t>(size, 2));
+    while (wrapped != 0) {
+        wrapped = limbs_add_1(result, result, size, wrapped);
+    }
+}
+
+
+/**
+ * @brief   Returns a number of scratch limbs large enough for any Karatsuba or Toom-3 product or square whose operands
+ *          have at most size limbs, its sub-products included.
+ *          A level needs at most 4 * size + 20 limbs for itself (Toom-3 products are the hungriest), and its
+ *          sub-products have at most ceil(size / 2) + 1 limbs.
+ * 
+ * @param size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_mul_scratch_bound(const uint64_t& size) {
+    if (size < 4 or (size < KARATSUBA_THRESHOLD and size < KARATSUBA_SQUARE_THRESHOLD)) {
+        return 0;
+    }
+    return 4 * size + 20 + limbs_mul_scratch_bound((size + 1) / 2 + 1);
+}
+
+
+/**
+ * @brief   Returns the number of scratch limbs needed by limbs_mul (or limbs_sqr) on operands of a_size and b_size limbs.
+ *          About 8 * max(a_size, b_size) limbs for balanced operands, 0 for the schoolbook and NTT products.
+ * 
+ * @param a_size 
+ * @param b_size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_mul_scratch_size(uint64_t a_size, uint64_t b_size) {
+    if (a_size < b_size) {
+        swap(a_size, b_size);
+    }
+    if (b_size >= NTT_THRESHOLD) {
+        return 0;
+    }
+    //  Very unbalanced products keep a chunk product next to the scratch of a b_size limbs product.
+    if (b_size <= (a_size + 1) / 2) {
+        uint64_t bound = limbs_mul_scratch_bound(b_size);
+        return bound > 0 ? 2 * b_size + bound : 0;
+    }
+    return limbs_mul_scratch_bound(a_size);
+}
+
+
+/**
+ * @brief   Returns a number of scratch limbs large enough for limbs_mul and limbs_sqr on any operands of at most size
+ *          limbs. Products whose smaller operand has NTT_THRESHOLD limbs or more need none, and the others have at most
+ *          2 * NTT_THRESHOLD limbs, so this stays bounded however large size is.
+ * 
+ * @param size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_mul_scratch_max(const uint64_t& size) {
+    return limbs_mul_scratch_bound(min(size, 2 * NTT_THRESHOLD));
+}
+
+
+/**
+ * @brief   Product of very unbalanced operands (a_size >= 2 * b_size). a is cut in chunks of b_size limbs which are
+ *          multiplied by b one at a time, so that every sub-product is balanced.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @param scratch 2 * b_size limbs, followed by the scratch of a b_size limbs product.
+ */
+static void limbs_mul_unbalanced(uint64_t* result, const uint64_t* a, const uint64_t& a_size, const uint64_t* b, const uint64_t& b_size, uint64_t* scratch) {
+    uint64_t* chunk_product = scratch;
+    uint64_t* product_scratch = scratch + 2 * b_size;
+
+    limbs_mul(result, a, b_size, b, b_size, product_scratch);
+
+    for (uint64_t offset = b_size; offset < a_size; offset += b_size) {
+        uint64_t chunk_size = min(b_size, a_size - offset);
+        limbs_mul(chunk_product, a + offset, chunk_size, b, b_size, product_scratch);
+
+        //  The lower b_size limbs overlap the previous chunk product, the rest is new.
+        for (uint64_t i = b_size; i < chunk_size + b_size; i++) {
+            result[offset + i] = chunk_product[i];
+        }
+        limbs_add(result + offset, result + offset, chunk_size + b_size, chunk_product, b_size);
+    }
+}
+
+
+/**
+ * @brief   Computes result = a * b, picking the algorithm according to the operand sizes.
+ *          result must hold a_size + b_size limbs and must not overlap a or b. Sizes must be at least 1.
+ * 
+ * @param result 
+ * @param a 
+ * @param a_size 
+ * @param b 
+ * @param b_size 
+ * @param scratch   limbs_mul_scratch_size(a_size, b_size) limbs, or null to have them allocated (once for the whole
+ *                  recursion).
+ */
+static void limbs_mul(uint64_t* result, const uint64_t* a, uint64_t a_size, const uint64_t* b, uint64_t b_size, uint64_t* scratch) {
+    if (a == b and a_size == b_size) {
+        limbs_sqr(result, a, a_size, scratch);
+        return;
+    }
+
+    if (a_size < b_size) {
+        swap(a, b);
+        swap(a_size, b_size);
+    }
+
+    //  Karatsuba needs at least 4 limbs to make any progress, whatever the threshold says.
+    if (b_size < KARATSUBA_THRESHOLD or b_size < 4) {
+        BIGINT_STATS_TIER(STATS_SCHOOLBOOK);
+        limbs_mul_basecase(result, a, a_size, b, b_size);
+        return;
+    }
+    if (b_size >= NTT_THRESHOLD) {
+        BIGINT_STATS_TIER(STATS_NTT);
+        limbs_mul_ntt(result, a, a_size, b, b_size);
+        return;
+    }
+
+    scratch_vector buffer(bigint_memory_resource());
+    if (scratch == nullptr) {
+        buffer.resize(limbs_mul_scratch_size(a_size, b_size));
+        scratch = buffer.data();
+    }
+
+    if (b_size <= (a_size + 1) / 2) {
+        BIGINT_STATS_TIER(STATS_UNBALANCED);
+        limbs_mul_unbalanced(result, a, a_size, b, b_size, scratch);
+    }
+    else if (b_size >= TOOM3_THRESHOLD and b_size > 2 * ((a_size + 2) / 3)) {
+        BIGINT_STATS_TIER(STATS_TOOM3);
+        limbs_mul_toom3(result, a, a_size, b, b_size, scratch);
+    }
+    else {
+        BIGINT_STATS_TIER(STATS_KARATSUBA);
+        limbs_mul_karatsuba(result, a, a_size, b, b_size, scratch);
+    }
+}
+
+
+/**
+ * @brief   Computes result = a^2, picking the algorithm according to size. result must hold 2 * size limbs
+ *          and must not overlap a.
+ * 
+ * @param result 
+ * @param a 
+ * @param size 
+ * @param scratch   limbs_mul_scratch_size(size, size) limbs, or null to have them allocated (once for the whole
+ *                  recursion).
+ */
+static void limbs_sqr(uint64_t* result, const uint64_t* a, const uint64_t& size, uint64_t* scratch) {
+    if (size < KARATSUBA_SQUARE_THRESHOLD or size < 4) {
+        BIGINT_STATS_TIER(STATS_SCHOOLBOOK);
+        limbs_sqr_basecase(result, a, size);
+        return;
+    }
+    if (size >= NTT_THRESHOLD) {
+        BIGINT_STATS_TIER(STATS_NTT);
+        limbs_mul_ntt(result, a, size, a, size);
+        return;
+    }
+
+    scratch_vector buffer(bigint_memory_resource());
+    if (scratch == nullptr) {
+        buffer.resize(limbs_mul_scratch_size(size, size));
+        scratch = buffer.data();
+    }
+
+    if (size >= TOOM3_SQUARE_THRESHOLD and size > 2 * ((size + 2) / 3)) {
+        BIGINT_STATS_TIER(STATS_TOOM3);
+        limbs_sqr_toom3(result, a, size, scratch);
+    }
+    else {
+        BIGINT_STATS_TIER(STATS_KARATSUBA);
+        limbs_sqr_karatsuba(result, a, size, scratch);
+    }
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------DIVISION----------------------------------------
+
+/*  Divisions are performed on a normalized divisor (most significant bit set), which both operands are shifted to.
+    Short divisions use Knuth's algorithm D. Above DIVISION_DC_THRESHOLD limbs, the recursive algorithm of
+    Burnikel and Ziegler computes the high and low halves of the quotient by dividing by the high half of the
+    divisor only, and then corrects them with one multiplication each. Its products are a fixed fraction of the
+    work at every level of recursion, which is what Karatsuba and Toom-3 products need to keep division within a
+    small multiple of a multiplication, but NTT products are fast enough for the number of levels to show.
+    Above DIVISION_NEWTON_THRESHOLD limbs, the reciprocal of the divisor is therefore computed by Newton's
+    iteration, whose cost is dominated by its last step, and each block of the quotient is then read from a single
+    product by the reciprocal (Barrett's reduction).
+    All the products of a division share one scratch buffer, of limbs_div_scratch_size limbs.
+*/
+
+/**
+ * @brief   Size (in limbs) of the divisor and quotient from which division switches to the recursive algorithm.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t DIVISION_DC_THRESHOLD = 40;
+
+
+/**
+ * @brief   Size (in limbs) of the divisor and quotient from which division switches to Newton's iteration.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t DIVISION_NEWTON_THRESHOLD = 32000;
+
+
+/**
+ * @brief   Knuth's algorithm D. Divides a by d, d being normalized and at least 2 limbs long.
+ *          The quotient (a_size - d_size limbs) is stored in quotient and the remainder replaces the d_size lowest limbs of a.
+ *          Returns the most significant limb of the quotient, 0 or 1.
+ * 
+ * @param quotient 
+ * @param a 
+ * @param a_size 
+ * @param d 
+ * @param d_size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_div_basecase(uint64_t* quotient, uint64_t* a, const uint64_t& a_size, const uint64_t* d, const uint64_t& d_size) {
+    uint64_t quotient_size = a_size - d_size;
+    uint64_t quotient_high = 0;
+
+    if (limbs_cmp(a + quotient_size, d, d_size) >= 0) {
+        limbs_sub_n(a + quotient_size, a + quotient_size, d, d_size);
+        quotient_high = 1;
+    }
+
+    uint64_t d1 = d[d_size - 1], d0 = d[d_size - 2];
+    uint64_t reciprocal = reciprocal_64(d1);
+
+    for (uint64_t j = quotient_size; j > 0; j--) {
+        uint64_t* window = a + j - 1;
+        uint64_t u2 = window[d_size], u1 = window[d_size - 1], u0 = window[d_size - 2];
+        uint64_t estimate;
+
+        //  Estimate the quotient digit from the 3 leading limbs. u2 > d1 is impossible since the remainder is smaller than d.
+        if (u2 == d1) {
+            estimate = UINT64_MAX;
+        }
+        else {
+            uint64_t rest, high;
+            estimate = div_2by1_preinv(u2, u1, d1, reciprocal, rest);
+            uint64_t low = mul_64_64(estimate, d0, high);
+            while (high > rest or (high == rest and low > u0)) {
+                estimate--;
+                high -= low < d0;
+                low -= d0;
+                rest += d1;
+                //  rest >= 2^64: the test above cannot succeed anymore.
+                if (rest < d1) {
+                    break;
+                }
+            }
+        }
+
+        uint64_t borrow = limbs_submul_1(window, d, d_size, estimate);
+        bool negative = window[d_size] < borrow;
+        window[d_size] -= borrow;
+
+        //  The estimate can still be 1 (rarely 2) too large, in which case d is added back.
+        while (negative) {
+            estimate--;
+            uint64_t carry = limbs_add_n(window, window, d, d_size);
+            window[d_size] += carry;
+            negative = not (carry == 1 and window[d_size] == 0);
+        }
+
+        quotient[j - 1] = estimate;
+    }
+
+    return quotient_high;
+}
+
+
+/**
+ * @brief   Recursive division of the 2 * size limbs a by the normalized size limbs d (Burnikel and Ziegler, in GMP's formulation).
+ *          The quotient (size limbs) is stored in quotient and the remainder replaces the size lowest limbs of a.
+ *          Returns the most significant limb of the quotient, 0 or 1. size must be at least 4.
+ * 
+ * @param quotient 
+ * @param a 
+ * @param d 
+ * @param size 
+ * @param scratch size + limbs_mul_scratch_max(size) limbs.
+ * @return uint64_t 
+ */
+static uint64_t limbs_div_dc_n(uint64_t* quotient, uint64_t* a, const uint64_t* d, const uint64_t& size, uint64_t* scratch) {
+    uint64_t low = size / 2, high = size - low;
+    uint64_t quotient_high, quotient_low, borrow;
+
+    //  High half of the quotient: divide the top 2 * high limbs by the top high limbs of d, then subtract the
+    //  quotient times the low limbs of d. The estimate can only be too large, and by very little.
+    if (high < DIVISION_DC_THRESHOLD or high < 4) {
+        quotient_high = limbs_div_basecase(quotient + low, a + 2 * low, 2 * high, d + low, high);
+    }
+    else {
+        quotient_high = limbs_div_dc_n(quotient + low, a + 2 * low, d + low, high, scratch);
+    }
+
+    limbs_mul(scratch, quotient + low, high, d, low, scratch + size);
+    borrow = limbs_sub_n(a + low, a + low, scratch, size);
+    if (quotient_high != 0) {
+        borrow += limbs_sub_n(a + size, a + size, d, low);
+    }
+    while (borrow != 0) {
+        quotient_high -= limbs_sub_1(quotient + low, quotient + low, high, 1);
+        borrow -= limbs_add_n(a + low, a + low, d, size);
+    }
+
+    //  Low half of the quotient, the same way.
+    if (low < DIVISION_DC_THRESHOLD or low < 4) {
+        quotient_low = limbs_div_basecase(quotient, a + high, 2 * low, d + high, low);
+    }
+    else {
+        quotient_low = limbs_div_dc_n(quotient, a + high, d + high, low, scratch);
+    }
+
+    limbs_mul(scratch, d, high, quotient, low, scratch + size);
+    borrow = limbs_sub_n(a, a, scratch, size);
+    if (quotient_low != 0) {
+        borrow += limbs_sub_n(a + low, a + low, d, high);
+    }
+    while (borrow != 0) {
+        limbs_sub_1(quotient, quotient, low, 1);
+        borrow -= limbs_add_n(a, a, d, size);
+    }
+
+    return quotient_high;
+}
+
+
+/**
+ * @brief   Returns the size of a cyclic NTT product (see limbs_mul_ntt_cyclic) that is enough to recover a product of
+ *          product_size limbs whose value is known up to a small multiple of B^known_size, or 0 if a full product would
+ *          use transforms as short.
+ * 
+ * @param known_size 
+ * @param product_size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_cyclic_size(const uint64_t& known_size, const uint64_t& product_size) {
+    uint64_t size = 1, full_size = 1;
+    while (size < known_size) {
+        size *= 2;
+    }
+    while (full_size < product_size - 1) {
+        full_size *= 2;
+    }
+    return size < full_size ? size : 0;
+}
+
+
+/**
+ * @brief   Recovers a value r, with 0 <= r + offset * (B^size - 1) < (B - 1) * (B^size - 1), from r mod (B^size - 1) and r mod B.
+ *          r is stored in two's complement on size + 1 limbs.
+ * 
+ * @param r The size limbs of r mod (B^size - 1) on input, which may be B^size - 1 for 0. size + 1 limbs.
+ * @param size 
+ * @param r_low r mod B.
+ * @param offset 
+ */
+static void limbs_cyclic_recover(uint64_t* r, const uint64_t& size, const uint64_t& r_low, const uint64_t& offset) {
+    if (all_of(r, r + size, [](uint64_t limb) { return limb == UINT64_MAX; })) {
+        fill(r, r + size, 0ULL);
+    }
+
+    //  r + offset * (B^size - 1) = r_mod + k * (B^size - 1), where k is read from the lowest limb.
+    uint64_t k = r[0] - (r_low - offset);
+    uint64_t multiple = k - offset;
+    r[size] = multiple;
+    if (static_cast<int64_t>(multiple) >= 0) {
+        limbs_sub_1(r, r, size + 1, multiple);
+    }
+    else {
+        limbs_add_1(r, r, size + 1, -multiple);
+    }
+}
+
+
+/**
+ * @brief   Computes t = B^(n + high) - d * x_high for limbs_invert_approx from a cyclic product, decrementing x_high
+ *          until t is positive.
+ *          Since t is known to be within 2 * B^n of 0, d * x_high mod (B^size - 1) and mod B are enough to get it.
+ * 
+ * @param t size + 1 limbs (the top ones end up 0).
+ * @param x_high high + 1 limbs.
+ * @param d 
+ * @param n 
+ * @param high 
+ * @param size Power of 2, at least n.
+ */
+static void limbs_invert_residual(uint64_t* t, uint64_t* x_high, const uint64_t* d, const uint64_t& n, const uint64_t& high,
+                                  const uint64_t& size) {
+    //  -d * x_high is the complement of d * x_high modulo B^size - 1, and B^(n + high) is B^((n + high) % size).
+    limbs_mul_ntt_cyclic(t, d, n, x_high, high + 1, size);
+    for (uint64_t i = 0; i < size; i++) {
+        t[i] = ~t[i];
+    }
+    uint64_t shift = (n + high) % size;
+    if (limbs_add_1(t + shift, t + shift, size - shift, 1) != 0) {
+        limbs_add_1(t, t, size, 1);
+    }
+    limbs_cyclic_recover(t, size, 0ULL - d[0] * x_high[0], 3);
+
+    while (static_cast<int64_t>(t[size]) < 0 or limbs_normalized_size(t, size + 1) == 0) {
+        limbs_sub_1(x_high, x_high, high + 1, 1);
+        limbs_add(t, t, size + 1, d, n);
+    }
+}
+
+
+/**
+ * @brief   Computes an approximate reciprocal of the normalized n limbs d: the n + 1 limbs x such that
+ *          d * x < B^2n <= d * (x + 2). The most significant limb of x is always 1.
+ *          Newton's iteration (Brent and Zimmermann's ApproximateReciprocal) gets x from the reciprocal of the top half
+ *          of d with two products, so that the whole computation costs about as much as these two products at the top
+ *          level.
+ * 
+ * @param x 
+ * @param d 
+ * @param n At least 2.
+ * @param scratch limbs_invert_scratch_size(n) limbs.
+ */
+static void limbs_invert_approx(uint64_t* x, const uint64_t* d, const uint64_t& n, uint64_t* scratch) {
+    if (n < DIVISION_DC_THRESHOLD or n < 4) {
+        //  x = floor((B^2n - 1) / d).
+        fill(scratch, scratch + 2 * n, UINT64_MAX);
+        x[n] = limbs_div_basecase(x, scratch, 2 * n, d, n);
+        return;
+    }
+
+    //  The top high + 1 limbs of x are the reciprocal of the top high limbs of d.
+    uint64_t low = (n - 1) / 2, high = n - low;
+    limbs_invert_approx(x + low, d + low, high, scratch);
+
+    //  t = d * x_high, which must be smaller than B^(n + high).
+    uint64_t* t = scratch;
+    uint64_t* u = t + n + high + 1;
+    uint64_t cyclic_size = limbs_cyclic_size(n, n + high + 1);
+    if (high + 1 >= NTT_THRESHOLD and cyclic_size != 0) {
+        limbs_invert_residual(t, x + low, d, n, high, cyclic_size);
+    }
+    else {
+        limbs_mul(t, d, n, x + low, high + 1, u);
+        while (t[n + high] != 0) {
+            limbs_sub_1(x + low, x + low, high + 1, 1);
+            limbs_sub(t, t, n + high + 1, d, n);
+        }
+        limbs_neg(t, t, n + high);
+    }
+
+    //  Newton's correction: t is now positive and at most 2 * B^n, and its top high + 1 limbs
+    //  times x_high give the low limbs of x.
+    limbs_mul(u, t + low, high + 1, x + low, high + 1, u + 2 * high + 2);
+    fill(x, x + low, 0ULL);
+    limbs_add(x, x, n + 1, u + 2 * high - low, low + 2);
+}
+
+
+/**
+ * @brief Returns the number of scratch limbs limbs_invert_approx needs for a divisor of n limbs.
+ * 
+ * @param n 
+ * @return uint64_t 
+ */
+static uint64_t limbs_invert_scratch_size(const uint64_t& n) {
+    return 3 * n + 5 + limbs_mul_scratch_max(n);
+}
+
+
+/**
+ * @brief   Divides the n + block limbs a by the normalized n limbs d, for block <= n, when the n top limbs of a are
+ *          smaller than d. x holds the n low limbs of the reciprocal of d (see limbs_invert_approx).
+ *          The quotient (block limbs) is stored in quotient and the remainder replaces the n lowest limbs of a.
+ * 
+ * @param quotient 
+ * @param a 
+ * @param block 
+ * @param d 
+ * @param n 
+ * @param x 
+ * @param scratch 2 * (n + block) + limbs_mul_scratch_max(n) limbs.
+ */
+static void limbs_div_newton_block(uint64_t* quotient, uint64_t* a, const uint64_t& block, const uint64_t* d, const uint64_t& n,
+                                   const uint64_t* x, uint64_t* scratch) {
+    uint64_t* product = scratch;
+    uint64_t* product_scratch = scratch + 2 * (n + block);
+
+    //  The top limbs of a times the reciprocal: the estimate is never too large, and at most 4 too small.
+    limbs_mul(product, a + n, block, x, n, product_scratch);
+    limbs_add_n(quotient, product + n, a + n, block);
+
+    //  The remainder is smaller than 5 * d, so it only needs the low limbs of the quotient times d: a cyclic product
+    //  gives them for half the cost when the full one would just overflow a power of 2.
+    uint64_t cyclic_size = limbs_cyclic_size(n, n + block);
+    if (block >= NTT_THRESHOLD and cyclic_size != 0) {
+        uint64_t r_low = a[0] - quotient[0] * d[0];
+        limbs_mul_ntt_cyclic(product, quotient, block, d, n, cyclic_size);
+        uint64_t* folded = product + cyclic_size;
+        copy(a, a + min(n + block, cyclic_size), folded);
+        fill(folded + min(n + block, cyclic_size), folded + cyclic_size, 0ULL);
+        if (n + block > cyclic_size and limbs_add(folded, folded, cyclic_size, a + cyclic_size, n + block - cyclic_size) != 0) {
+            limbs_add_1(folded, folded, cyclic_size, 1);
+        }
+        if (limbs_sub_n(folded, folded, product, cyclic_size) != 0) {
+            limbs_sub_1(folded, folded, cyclic_size, 1);
+        }
+        limbs_cyclic_recover(folded, cyclic_size, r_low, 0);
+        copy(folded, folded + n + 1, a);
+        fill(a + n + 1, a + n + block, 0ULL);
+    }
+    else {
+        limbs_mul(product, quotient, block, d, n, product_scratch);
+        limbs_sub_n(a, a, product, n + block);
+    }
+    while (a[n] != 0 or limbs_cmp(a, d, n) >= 0) {
+        limbs_add_1(quotient, quotient, block, 1);
+        limbs_sub(a, a, n + 1, d, n);
+    }
+}
+
+
+/**
+ * @brief   Divides the 2 * size limbs a by the normalized size limbs d, with Newton's iteration from DIVISION_NEWTON_THRESHOLD
+ *          limbs on and the recursive algorithm below. The quotient (size limbs) is stored in quotient and the remainder
+ *          replaces the size lowest limbs of a. Returns the most significant limb of the quotient, 0 or 1. size must be
+ *          at least 4.
+ * 
+ * @param quotient 
+ * @param a 
+ * @param d 
+ * @param size 
+ * @param scratch limbs_div_scratch_size(2 * size, size) limbs.
+ * @return uint64_t 
+ */
+static uint64_t limbs_div_n(uint64_t* quotient, uint64_t* a, const uint64_t* d, const uint64_t& size, uint64_t* scratch) {
+    if (size < DIVISION_NEWTON_THRESHOLD) {
+        return limbs_div_dc_n(quotient, a, d, size, scratch);
+    }
+
+    uint64_t quotient_high = 0;
+    if (limbs_cmp(a + size, d, size) >= 0) {
+        limbs_sub_n(a + size, a + size, d, size);
+        quotient_high = 1;
+    }
+    uint64_t* x = scratch;
+    limbs_invert_approx(x, d, size, x + size + 1);
+    limbs_div_newton_block(quotient, a, size, d, size, x, x + size + 1);
+    return quotient_high;
+}
+
+
+/**
+ * @brief   Divides the d_size + block limbs a by the normalized d, for block < d_size, when the d_size top limbs of a are smaller than d.
+ *          The quotient is estimated by dividing the 2 * block top limbs of a by the block top limbs of d, then corrected.
+ * 
+ * @param quotient block limbs.
+ * @param a 
+ * @param block 
+ * @param d 
+ * @param d_size 
+ * @param scratch limbs_div_scratch_size(d_size + block, d_size) limbs.
+ */
+static void limbs_div_dc_block(uint64_t* quotient, uint64_t* a, const uint64_t& block, const uint64_t* d, const uint64_t& d_size, uint64_t* scratch) {
+    if (block < DIVISION_DC_THRESHOLD or block < 4) {
+        limbs_div_basecase(quotient, a, d_size + block, d, d_size);
+        return;
+    }
+
+    uint64_t rest = d_size - block;
+    uint64_t quotient_high = limbs_div_n(quotient, a + rest, d + rest, block, scratch);
+
+    limbs_mul(scratch, quotient, block, d, rest, scratch + d_size);
+    uint64_t borrow = limbs_sub_n(a, a, scratch, d_size);
+    if (quotient_high != 0) {
+        borrow += limbs_sub_n(a + block, a + block, d, rest);
+    }
+    while (borrow != 0) {
+        quotient_high -= limbs_sub_1(quotient, quotient, block, 1);
+        borrow -= limbs_add_n(a, a, d, d_size);
+    }
+}
+
+
+/**
+ * @brief   Returns the number of scratch limbs limbs_div_qr needs to divide a_size limbs by d_size limbs.
+ * 
+ * @param a_size 
+ * @param d_size 
+ * @return uint64_t 
+ */
+static uint64_t limbs_div_scratch_size(const uint64_t& a_size, const uint64_t& d_size) {
+    uint64_t quotient_size = a_size - d_size;
+    if (d_size < DIVISION_DC_THRESHOLD or quotient_size < DIVISION_DC_THRESHOLD or d_size < 4) {
+        return 0;
+    }
+
+    //  Recursive steps keep a product of d_size limbs. Newton's iteration keeps the reciprocal, and then the
+    //  temporaries of limbs_invert_approx or those of limbs_div_newton_block.
+    uint64_t size = d_size + limbs_mul_scratch_max(d_size);
+    if (min(d_size, quotient_size) >= DIVISION_NEWTON_THRESHOLD) {
+        uint64_t block = 4 * d_size + limbs_mul_scratch_max(d_size);
+        size = max(size, d_size + 1 + max(limbs_invert_scratch_size(d_size), block));
+    }
+    return size;
+}
+
+
+/**
+ * @brief   Divides a by the normalized d (at least 2 limbs). The quotient (a_size - d_size limbs) is stored in quotient and the
+ *          remainder replaces the d_size lowest limbs of a. Returns the most significant limb of the quotient, 0 or 1.
+ * 
+ * @param quotient 
+ * @param a 
+ * @param a_size 
+ * @param d 
+ * @param d_size 
+ * @param scratch limbs_div_scratch_size(a_size, d_size) limbs.
+ * @return uint64_t 
+ */
+static uint64_t limbs_div_qr(uint64_t* quotient, uint64_t* a, const uint64_t& a_size, const uint64_t* d, const uint64_t& d_size, uint64_t* scratch) {
+    uint64_t quotient_size = a_size - d_size;
+    if (d_size < DIVISION_DC_THRESHOLD or quotient_size < DIVISION_DC_THRESHOLD or d_size < 4) {
+        return limbs_div_basecase(quotient, a, a_size, d, d_size);
+    }
+
+    uint64_t quotient_high = 0;
+    if (limbs_cmp(a + quotient_size, d, d_size) >= 0) {
+        limbs_sub_n(a + quotient_size, a + quotient_size, d, d_size);
+        quotient_high = 1;
+    }
+
+    //  The quotient is computed from the top by blocks of d_size limbs, the first block taking the odd limbs.
+    uint64_t position = quotient_size;
+    uint64_t block = quotient_size % d_size == 0 ? d_size : quotient_size % d_size;
+
+    //  A long enough quotient pays for the reciprocal of the whole divisor, which then serves every block.
+    if (quotient_size >= d_size and d_size >= DIVISION_NEWTON_THRESHOLD) {
+        uint64_t* x = scratch;
+        limbs_invert_approx(x, d, d_size, x + d_size + 1);
+        while (position > 0) {
+            uint64_t start = position - block;
+            limbs_div_newton_block(quotient + start, a + start, block, d, d_size, x, x + d_size + 1);
+            position = start;
+            block = d_size;
+        }
+        return quotient_high;
+    }
+
+    //  Otherwise each block is a 2n / n recursive division.
+    while (position > 0) {
+        uint64_t start = position - block;
+        if (block == d_size) {
+            limbs_div_dc_n(quotient + start, a + start, d, d_size, scratch);
+        }
+        else {
+            limbs_div_dc_block(quotient + start, a + start, block, d, d_size, scratch);
+        }
+        position = start;
+        block = d_size;
+    }
+
+    return quotient_high;
+}
+
+
+/**
+ * @brief   Computes the quotient (a_size - d_size + 1 limbs) and remainder (d_size limbs) of a / d.
+ *          a_size >= d_size >= 1 and the most significant limb of d must not be 0.
+ * 
+ * @param quotient 
+ * @param remainder 
+ * @param a 
+ * @param a_size 
+ * @param d 
+ * @param d_size 
+ */
+static void limbs_divrem(uint64_t* quotient, uint64_t* remainder, const uint64_t* a, const uint64_t& a_size, const uint64_t* d, const uint64_t& d_size) {
+    if (d_size == 1) {
+        remainder[0] = limbs_divrem_1(quotient, a, a_size, d[0]);
+        return;
+    }
+
+    //  Both operands are shifted so that the divisor is normalized. a gets an extra limb so the quotient cannot overflow.
+    //  The division's scratch comes in the same buffer.
+    unsigned shift = count_leading_zeros_64(d[d_size - 1]);
+    scratch_vector buffer(a_size + 1 + d_size + limbs_div_scratch_size(a_size + 1, d_size), bigint_memory_resource());
+    uint64_t* a_norm = buffer.data();
+    uint64_t* d_norm = a_norm + a_size + 1;
+
+    if (shift != 0) {
+        a_norm[a_size] = limbs_lshift(a_norm, a, a_size, shift);
+        limbs_lshift(d_norm, d, d_size, shift);
+    }
+    else {
+        copy(a, a + a_size, a_norm);
+        a_norm[a_size] = 0ULL;
+        copy(d, d + d_size, d_norm);
+    }
+
+    limbs_div_qr(quotient, a_norm, a_size + 1, d_norm, d_size, d_norm + d_size);
+
+    if (shift != 0) {
+        limbs_rshift(remainder, a_norm, d_size, shift);
+    }
+    else {
+        copy(a_norm, a_norm + d_size, remainder);
+    }
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------CONVERSIONS----------------------------------------
+
+/*  Conversions to strings in bases that are not powers of 2 split the number by powers base^(c * 2^k), c being the
+    number of digits that fit in a limb (19 in base 10). These powers are computed once per thread and base, and
+    cached. Each half is converted recursively and written straight into its final place in a single preallocated
+    buffer. The number is divided in place, its quotients going to one work area allocated up front, so the whole
+    recursion allocates once. Small enough pieces are written c digits at a time, using single limb divisions by base^c.
+    Powers of 2 bases only need to cut the limbs into groups of bits, in a single pass.
+*/
+
+/**
+ * @brief Digits of bases up to 36.
+ * 
+ */
+static const char DIGIT_CHARACTERS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/**
+ * @brief   Size (in limbs) below which conversions to strings stop splitting numbers and work limb by limb.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t TO_STRING_DC_THRESHOLD = 30;
+
+
+/**
+ * @brief Chunks of digits of a base: the most digits that fit in a limb, and the corresponding power of the base.
+ * 
+ */
+struct radix_chunk {
+    uint64_t base;
+    uint64_t digits;
+    uint64_t power;
+};
+
+
+/**
+ * @brief Computes the radix_chunk of every base up to 36, indexed by base.
+ * 
+ * @return vector<radix_chunk> 
+ */
+static vector<radix_chunk> make_radix_chunks() {
+    vector<radix_chunk> chunks(37);
+    for (uint64_t base = 2; base <= 36; base++) {
+        radix_chunk& chunk = chunks[base];
+        chunk.base = base;
+        chunk.digits = 0;
+        chunk.power = 1;
+        while (chunk.power <= UINT64_MAX / base) {
+            chunk.power *= base;
+            chunk.digits++;
+        }
+    }
+    return chunks;
+}
+
+
+/**
+ * @brief Computed once, at static initialization.
+ * 
+ */
+static const vector<radix_chunk> RADIX_CHUNKS = make_radix_chunks();
+
+
+/**
+ * @brief Returns log2(base) if base is a power of 2, 0 otherwise.
+ * 
+ * @param base 
+ * @return unsigned 
+ */
+static unsigned radix_bits(const uint64_t& base) {
+    if ((base & (base - 1)) != 0) {
+        return 0;
+    }
+    return 63 - count_leading_zeros_64(base);
+}
+
+
+/**
+ * @brief Throws an invalid_argument if base is not supported.
+ * 
+ * @param base 
+ */
+static void check_radix(const uint64_t& base) {
+    if (base < 2 or base > 36) {
+        throw invalid_argument("Base must be between 2 and 36.");
+    }
+}
+
+
+/**
+ * @brief   Returns (chunk.power)^(2^level) as an array of limbs. Powers are computed by successive squarings the
+ *          first time they are needed and then kept for the whole life of the calling thread.
+ * 
+ * @param chunk 
+ * @param level 
+ * @return const vector<uint64_t>& 
+ */
+static const vector<uint64_t>& power_of_radix(const radix_chunk& chunk, const uint64_t& level) {
+    thread_local vector<vector<vector<uint64_t>>> all_powers(37);
+    vector<vector<uint64_t>>& powers = all_powers[chunk.base];
+
+    if (powers.empty()) {
+        powers.push_back(vector<uint64_t>(1, chunk.power));
+    }
+    while (powers.size() <= level) {
+        const vector<uint64_t>& last = powers.back();
+        uint64_t size = last.size();
+        vector<uint64_t> square(2 * size);
+        limbs_sqr(square.data(), last.data(), size);
+        square.resize(limbs_normalized_size(square.data(), 2 * size));
+        powers.push_back(std::move(square));
+    }
+    return powers[level];
+}
+
+
+/**
+ * @brief Writes the chunk.digits digits of value (with leading 0s) to out.
+ * 
+ * @param out 
+ * @param value Smaller than chunk.power.
+ * @param chunk 
+ */
+static void write_chunk(char* out, uint64_t value, const radix_chunk& chunk) {
+    //  Decimal gets its own loop, in which divisions by the constant 10 become multiplications.
+    if (chunk.base == 10) {
+        for (int i = 18; i >= 0; i--) {
+            out[i] = (char) ('0' + value % 10);
+            value /= 10;
+        }
+        return;
+    }
+    for (uint64_t i = chunk.digits; i > 0; i--) {
+        out[i - 1] = DIGIT_CHARACTERS[value % chunk.base];
+        value /= chunk.base;
+    }
+}
+
+
+/**
+ * @brief   Returns the number of scratch limbs limbs_to_radix needs to convert size limbs at the given level: at each
+ *          level, the quotient and the shifted power (for the division) or the scratch of the next level.
+ * 
+ * @param size 
+ * @param level 
+ * @param chunk 
+ * @return uint64_t 
+ */
+static uint64_t limbs_to_radix_scratch_size(const uint64_t& size, const uint64_t& level, const radix_chunk& chunk) {
+    if (size < TO_STRING_DC_THRESHOLD or level == 0) {
+        return 0;
+    }
+    uint64_t power_size = power_of_radix(chunk, level - 1).size();
+    if (size < power_size) {
+        return limbs_to_radix_scratch_size(size, level - 1, chunk);
+    }
+    uint64_t quotient_size = size + 1 - power_size;
+    uint64_t division = power_size + limbs_div_scratch_size(size + 1, power_size);
+    return quotient_size + 1 + max(division, limbs_to_radix_scratch_size(max(power_size, quotient_size), level - 1, chunk));
+}
+
+
+/**
+ * @brief   Writes exactly chunk.digits * 2^level digits of a (with leading 0s) to out. a must be smaller than
+ *          base^(chunk.digits * 2^level). The limbs of a are used as scratch space, and a must have room for one more limb.
+ *          a is divided in place: the quotient goes to the start of scratch and the remainder stays in the low limbs
+ *          of a, and both are converted where they are.
+ * 
+ * @param out 
+ * @param a 
+ * @param size 
+ * @param level 
+ * @param chunk 
+ * @param scratch limbs_to_radix_scratch_size(size, level, chunk) limbs.
+ */
+static void limbs_to_radix(char* out, uint64_t* a, uint64_t size, const uint64_t& level, const radix_chunk& chunk, uint64_t* scratch) {
+    uint64_t digits = chunk.digits << level;
+    size = limbs_normalized_size(a, size);
+
+    if (size < TO_STRING_DC_THRESHOLD or level == 0) {
+        //  Chunks are peeled off from the least significant end.
+        char* position = out + digits;
+        while (size > 0) {
+            position -= chunk.digits;
+            write_chunk(position, limbs_divrem_1(a, a, size, chunk.power), chunk);
+            size = limbs_normalized_size(a, size);
+        }
+        fill(out, position, '0');
+        return;
+    }
+
+    //  a = high * base^(chunk.digits * 2^(level - 1)) + low, both halves get exactly half the digits.
+    const vector<uint64_t>& power = power_of_radix(chunk, level - 1);
+    uint64_t power_size = power.size();
+    if (size < power_size or (size == power_size and limbs_cmp(a, power.data(), size) < 0)) {
+        fill(out, out + digits / 2, '0');
+        limbs_to_radix(out + digits / 2, a, size, level - 1, chunk, scratch);
+        return;
+    }
+
+    //  Both operands are shifted so that the power is normalized, a into its extra limb, which keeps the top of the
+    //  quotient 0.
+    uint64_t quotient_size = size + 1 - power_size;
+    uint64_t* quotient = scratch;
+    uint64_t* power_norm = quotient + quotient_size + 1;
+    unsigned shift = count_leading_zeros_64(power.back());
+    if (shift != 0) {
+        a[size] = limbs_lshift(a, a, size, shift);
+        limbs_lshift(power_norm, power.data(), power_size, shift);
+    }
+    else {
+        a[size] = 0ULL;
+        copy(power.begin(), power.end(), power_norm);
+    }
+    limbs_div_qr(quotient, a, size + 1, power_norm, power_size, power_norm + power_size);
+    if (shift != 0) {
+        limbs_rshift(a, a, power_size, shift);
+    }
+
+    //  The quotient is converted first, so that the low half can take its place in the scratch.
+    limbs_to_radix(out, quotient, quotient_size, level - 1, chunk, quotient + quotient_size + 1);
+    limbs_to_radix(out + digits / 2, a, power_size, level - 1, chunk, scratch);
+}
+
+
+/**
+ * @brief   Writes the digit_count least significant digits of a in base 2^bits to out, most significant first.
+ *          Each digit is read directly from its bits, in a single pass.
+ * 
+ * @param out 
+ * @param a 
+ * @param size 
+ * @param bits From 1 to 5.
+ * @param digit_count At most (64 * size + bits - 1) / bits.
+ */
+static void limbs_to_power_of_2_radix(char* out, const uint64_t* a, const uint64_t& size, const unsigned& bits, const uint64_t& digit_count) {
+    uint64_t mask = (1ULL << bits) - 1;
+    for (uint64_t i = 0; i < digit_count; i++) {
+        uint64_t position = i * bits, limb = position / 64;
+        unsigned offset = (unsigned) (position % 64);
+        uint64_t value = a[limb] >> offset;
+        if (offset + bits > 64 and limb + 1 < size) {
+            value |= a[limb + 1] << (64 - offset);
+        }
+        out[digit_count - 1 - i] = DIGIT_CHARACTERS[value & mask];
+    }
+}
+
+
+/*  Conversions from strings work the other way around: the string is cut in chunks of chunk.digits digits (each of
+    which fits in a limb) from its end, and chunks are combined pairwise, then by groups of 4, 8... using the same
+    cached powers and the fast multiplication tiers. Powers of 2 bases are again a single pass.
+*/
+
+/**
+ * @brief   Size (in chunks of digits) below which conversions from strings stop splitting numbers and combine chunks one by one.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t FROM_STRING_DC_THRESHOLD = 30;
+
+
+/**
+ * @brief Reads a chunk of digits, which must fit in a limb.
+ * 
+ * @param digits 
+ * @param length 
+ * @param base 
+ * @return uint64_t 
+ */
+static uint64_t read_digits(const char* digits, const uint64_t& length, const uint64_t& base) {
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < length; i++) {
+        value = base * value + digit_value(digits[i]);
+    }
+    return value;
+}
+
+
+/**
+ * @brief   Reads the index-th chunk of digits of a string of digits, starting from its end. The first chunk can be shorter.
+ * 
+ * @param digits 
+ * @param digit_count 
+ * @param index 
+ * @param chunk 
+ * @return uint64_t 
+ */
+static uint64_t read_chunk(const char* digits, const uint64_t& digit_count, const uint64_t& index, const radix_chunk& chunk) {
+    uint64_t end = digit_count - chunk.digits * index;
+    uint64_t start = end > chunk.digits ? end - chunk.digits : 0;
+    return read_digits(digits + start, end - start, chunk.base);
+}
+
+
+/**
+ * @brief   Computes the value of the 2^level chunks of digits starting from chunk first_chunk (see read_chunk), chunks past
+ *          the start of the string being 0s. result must hold 2^level limbs. Returns the normalized size of the result.
+ *          Both halves are computed in place in result, and only their combination goes through scratch, which every
+ *          level shares.
+ * 
+ * @param result 
+ * @param digits 
+ * @param digit_count 
+ * @param first_chunk 
+ * @param level 
+ * @param chunk 
+ * @param scratch limbs_from_radix_scratch_size(level) limbs.
+ * @return uint64_t 
+ */
+static uint64_t limbs_from_radix(uint64_t* result, const char* digits, const uint64_t& digit_count, const uint64_t& first_chunk,
+                                 const uint64_t& level, const radix_chunk& chunk, uint64_t* scratch) {
+    uint64_t chunk_count = (digit_count + chunk.digits - 1) / chunk.digits;
+    if (first_chunk >= chunk_count) {
+        return 0;
+    }
+    uint64_t available = min<uint64_t>(chunk_count - first_chunk, 1ULL << level);
+
+    if (available < FROM_STRING_DC_THRESHOLD or level == 0) {
+        //  Horner's scheme, from the most significant chunk. The value always fits in one more limb.
+        uint64_t size = 0;
+        for (uint64_t i = available; i > 0; i--) {
+            uint64_t high = limbs_mul_1(result, result, size, chunk.power);
+            high += limbs_add_1(result, result, size, read_chunk(digits, digit_count, first_chunk + i - 1, chunk));
+            if (high != 0) {
+                result[size++] = high;
+            }
+        }
+        return limbs_normalized_size(result, size);
+    }
+
+    //  value = high * base^(chunk.digits * 2^(level - 1)) + low. Both halves fit in half the limbs of result.
+    uint64_t half = 1ULL << (level - 1);
+    uint64_t low_size = limbs_from_radix(result, digits, digit_count, first_chunk, level - 1, chunk, scratch);
+    uint64_t high_size = limbs_from_radix(result + half, digits, digit_count, first_chunk + half, level - 1, chunk, scratch);
+    if (high_size == 0) {
+        return low_size;
+    }
+
+    const vector<uint64_t>& power = power_of_radix(chunk, level - 1);
+    uint64_t size = high_size + power.size();
+    limbs_mul(scratch, result + half, high_size, power.data(), power.size(), scratch + (1ULL << level));
+    if (low_size > 0) {
+        limbs_add(scratch, scratch, size, result, low_size);
+    }
+    copy(scratch, scratch + size, result);
+    return limbs_normalized_size(result, size);
+}
+
+
+/**
+ * @brief   Returns the number of scratch limbs limbs_from_radix needs at the given level: the 2^level limbs of the
+ *          top product, and the scratch of that product.
+ * 
+ * @param level 
+ * @return uint64_t 
+ */
+static uint64_t limbs_from_radix_scratch_size(const uint64_t& level) {
+    if (level == 0) {
+        return 0;
+    }
+    return (1ULL << level) + limbs_mul_scratch_max(1ULL << (level - 1));
+}
+
+
+/**
+ * @brief   Computes the value of a string of digits in base 2^bits, each digit being or-ed directly into its bits in a
+ *          single pass. result must hold (digit_count * bits + 63) / 64 limbs, set to 0.
+ * 
+ * @param result 
+ * @param digits 
+ * @param digit_count 
+ * @param bits From 1 to 5.
+ */
+static void limbs_from_power_of_2_radix(uint64_t* result, const char* digits, const uint64_t& digit_count, const unsigned& bits) {
+    for (uint64_t i = 0; i < digit_count; i++) {
+        uint64_t value = digit_value(digits[digit_count - 1 - i]), position = i * bits, limb = position / 64;
+        unsigned offset = (unsigned) (position % 64);
+        result[limb] |= value << offset;
+        if (offset + bits > 64) {
+            result[limb + 1] |= value >> (64 - offset);
+        }
+    }
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------PRIVATE METHODS AND PROCEDURES----------------------------------------
+
+void bigint::remove_empty_values() {
+    while (values.size() > 1 and values.back() == 0) {
+        values.pop_back();
+    }
+
+    //  Zero is always positive.
+    if (values.size() == 1 and values[0] == 0) {
+        sign = 1;
+    }
+}
+
+
+void bigint::assign_shift_left(const bigint& source, const uint64_t& bits) {
+    uint64_t size = source.values.size(), limbs = bits / 64;
+    unsigned offset = (unsigned) (bits % 64);
+    int8_t source_sign = source.sign;
+
+    //  The limbs are moved from the most significant one down, so that source can be the caller.
+    values.resize(size + limbs + 1);
+    uint64_t* data = values.data();
+    const uint64_t* source_data = &source == this ? data : source.values.data();
+    if (offset != 0) {
+        data[size + limbs] = limbs_lshift(data + limbs, source_data, size, offset);
+    }
+    else if (limbs != 0 or source_data != data) {
+        for (uint64_t i = size; i > 0; i--) {
+            data[i - 1 + limbs] = source_data[i - 1];
+        }
+    }
+    fill(data, data + limbs, 0ULL);
+    sign = source_sign;
+    remove_empty_values();
+}
+
+
+void bigint::assign_shift_right(const bigint& source, const uint64_t& bits) {
+    uint64_t size = source.values.size(), limbs = bits / 64;
+    unsigned offset = (unsigned) (bits % 64);
+    int8_t source_sign = source.sign;
+
+    //  Rounding towards minus infinity adds 1 to the magnitude of negative values when any 1 is shifted out.
+    bool round_up = false;
+    if (source_sign < 0) {
+        for (uint64_t i = 0; i < min(limbs, size) and not round_up; i++) {
+            round_up = source.values[i] != 0;
+        }
+        round_up = round_up or (limbs < size and offset != 0 and (source.values[limbs] << (64 - offset)) != 0);
+    }
+
+    if (limbs >= size) {
+        values.assign(1, round_up ? 1ULL : 0ULL);
+        sign = source_sign;
+        remove_empty_values();
+        return;
+    }
+
+    //  The limbs are moved from the least significant one up, so that source can be the caller.
+    uint64_t new_size = size - limbs;
+    if (&source == this) {
+        uint64_t* data = values.data();
+        if (offset != 0) {
+            limbs_rshift(data, data + limbs, new_size, offset);
+        }
+        else if (limbs != 0) {
+            copy(data + limbs, data + size, data);
+        }
+        values.resize(new_size);
+    }
+    else {
+        values.resize(new_size);
+        if (offset != 0) {
+            limbs_rshift(values.data(), source.values.data() + limbs, new_size, offset);
+        }
+        else {
+            copy(source.values.begin() + limbs, source.values.end(), values.begin());
+        }
+    }
+
+    if (round_up) {
+        uint64_t carry = limbs_add_1(values.data(), values.data(), new_size, 1);
+        if (carry != 0) {
+            values.push_back(carry);
+        }
+    }
+    sign = source_sign;
+    remove_empty_values();
+}
+
+
+void bigint::assign_bitwise(const bigint& second_int, const char& operation) {
+    uint64_t a_size = values.size(), b_size = second_int.values.size(), size = max(a_size, b_size);
+    bool a_negative = sign < 0, b_negative = second_int.sign < 0, negative;
+    switch (operation) {
+        case '&': negative = a_negative and b_negative; break;
+        case '|': negative = a_negative or b_negative; break;
+        default: negative = a_negative != b_negative; break;
+    }
+
+    //  The two's complement of a negative x is ~(|x| - 1), and that of the result is converted back the same way
+    //  as ~result + 1. Borrows and carry are propagated along the single pass.
+    uint64_t a_borrow = a_negative, b_borrow = b_negative, carry = negative;
+    values.resize(size + 1);
+    const uint64_t* b_data = second_int.values.data();
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t a = i < a_size ? values[i] : 0, b = i < b_size ? b_data[i] : 0, limb;
+        if (a_negative) {
+            uint64_t difference = a - a_borrow;
+            a_borrow = a < a_borrow;
+            a = ~difference;
+        }
+        if (b_negative) {
+            uint64_t difference = b - b_borrow;
+            b_borrow = b < b_borrow;
+            b = ~difference;
+        }
+        switch (operation) {
+            case '&': limb = a & b; break;
+            case '|': limb = a | b; break;
+            default: limb = a ^ b; break;
+        }
+        if (negative) {
+            limb = ~limb + carry;
+            carry = limb == 0 and carry;
+        }
+        values[i] = limb;
+    }
+
+    //  Past both operands, the result is all 0s or all 1s, which complements to 0.
+    values[size] = negative ? carry : 0;
+    sign = negative ? -1 : 1;
+    remove_empty_values();
+}
+
+
+void bigint::assign_string(const string& number, const uint64_t& base) {
+    BIGINT_STATS_SCOPE(STATS_FROM_STRING, 0);
+    check_radix(base);
+    uint64_t start = 0;
+
+    if (number.length() > 0 and number[0] == '-') {
+        sign = -1;
+        start = 1;
+    }
+    else {
+        sign = 1;
+    }
+
+    //  Checking for incorrect characters in the string.
+    for (uint64_t i = start; i < number.length(); i++) {
+        if (digit_value(number[i]) >= base) {
+            throw invalid_argument("Number string should contain digits of its base only.");
+        }
+    }
+
+    const char* digits = number.data() + start;
+    uint64_t digit_count = number.length() - start;
+
+    unsigned bits = radix_bits(base);
+    if (bits != 0) {
+        uint64_t size = (digit_count * bits + 63) / 64;
+        values.assign(size > 0 ? size : 1, 0ULL);
+        limbs_from_power_of_2_radix(values.data(), digits, digit_count, bits);
+        remove_empty_values();
+        BIGINT_STATS_LIMBS(STATS_FROM_STRING, values.size());
+        return;
+    }
+
+    //  Smallest number of chunks of digits, as a power of 2, that holds the whole string.
+    const radix_chunk& chunk = RADIX_CHUNKS[base];
+    uint64_t level = 0;
+    while ((chunk.digits << level) < digit_count) {
+        level++;
+    }
+
+    values.assign(1ULL << level, 0ULL);
+    scratch_vector scratch(limbs_from_radix_scratch_size(level), bigint_memory_resource());
+    uint64_t size = limbs_from_radix(values.data(), digits, digit_count, 0, level, chunk, scratch.data());
+    values.resize(size > 0 ? size : 1);
+    remove_empty_values();
+    BIGINT_STATS_LIMBS(STATS_FROM_STRING, values.size());
+}
+
+
+void bigint::assign_add(const bigint& second_int, const int8_t& add_sign) {
+    uint64_t l1 = values.size(), l2 = second_int.values.size();
+    BIGINT_STATS_SCOPE(STATS_ADD, l1 + l2);
+
+    //  int8_t casts are here to prevent warnings.
+    //  Compute wether the actual operation is a sum or substraction.
+    int8_t effective_sign = (int8_t) ((int8_t) (sign * add_sign) * second_int.sign);
+
+    if (effective_sign > 0) {
+        //  The absolute values add up and the sign stays. Limbs are read after resizing, as second_int can be the caller.
+        if (l1 < l2) {
+            values.resize(l2);
+        }
+        uint64_t* result = values.data();
+        const uint64_t* second = second_int.values.data();
+        uint64_t carry = l1 >= l2 ? limbs_add(result, result, l1, second, l2) : limbs_add(result, second, l2, result, l1);
+        if (carry != 0) {
+            values.push_back(carry);
+        }
+        return;
+    }
+
+    //  Subtract the smaller absolute value from the larger one, which also gives the sign of the result.
+    int comparison = l1 != l2 ? (l1 > l2 ? 1 : -1) : limbs_cmp(values.data(), second_int.values.data(), l1);
+    if (comparison == 0) {
+        values.resize(1);
+        values[0] = 0;
+        sign = 1;
+        return;
+    }
+
+    if (comparison > 0) {
+        limbs_sub(values.data(), values.data(), l1, second_int.values.data(), l2);
+    }
+    else {
+        values.resize(l2);
+        limbs_sub(values.data(), second_int.values.data(), l2, values.data(), l1);
+        sign = (int8_t) -sign;
+    }
+
+    //  Only the front limbs can have been cleared.
+    remove_empty_values();
+}
+
+
+void bigint::assign_addmul(const bigint& a, const bigint& b, const int8_t& add_sign) {
+    uint64_t la = a.values.size(), lb = b.values.size();
+    BIGINT_STATS_SCOPE(STATS_MULTIPLY, la + lb);
+    if ((la == 1 and a.values[0] == 0) or (lb == 1 and b.values[0] == 0)) {
+        return;
+    }
+
+    //  Aliasing the caller would have its limbs change under the product.
+    if (&a == this or &b == this) {
+        bigint product = a * b;
+        assign_add(product, add_sign);
+        return;
+    }
+
+    if (la < lb) {
+        assign_addmul(b, a, add_sign);
+        return;
+    }
+
+    int8_t product_sign = (int8_t) (a.sign * b.sign * add_sign);
+    if (values.size() == 1 and values[0] == 0) {
+        sign = product_sign;
+    }
+    bool subtract = product_sign != sign;
+
+    //  One spare limb so that additions cannot overflow.
+    uint64_t size = max<uint64_t>(values.size(), la + lb) + 1;
+    values.resize(size, 0ULL);
+    uint64_t* r = values.data();
+    uint64_t borrow = 0;
+
+    if (lb < KARATSUBA_THRESHOLD) {
+        //  Rows are accumulated directly into the caller's limbs.
+        for (uint64_t j = 0; j < lb; j++) {
+            if (subtract) {
+                uint64_t row_borrow = limbs_submul_1(r + j, a.values.data(), la, b.values[j]);
+                borrow += limbs_sub_1(r + j + la, r + j + la, size - j - la, row_borrow);
+            }
+            else {
+                uint64_t carry = limbs_addmul_1(r + j, a.values.data(), la, b.values[j]);
+                limbs_add_1(r + j + la, r + j + la, size - j - la, carry);
+            }
+        }
+    }
+    else {
+        scratch_vector product(la + lb, bigint_memory_resource());
+        limbs_mul(product.data(), a.values.data(), la, b.values.data(), lb);
+        if (subtract) {
+            borrow = limbs_sub(r, r, size, product.data(), la + lb);
+        }
+        else {
+            limbs_add(r, r, size, product.data(), la + lb);
+        }
+    }
+
+    //  The product was larger than the caller: the limbs hold the two's complement of the result.
+    if (borrow != 0) {
+        limbs_neg(r, r, size);
+        sign = (int8_t) -sign;
+    }
+
+    remove_empty_values();
+}
+
+
+
+
+
+
+
+
+template<typename T>
+uint64_t bigint::split_integer(const T& n, int8_t& n_sign) {
+    if constexpr (is_signed<T>::value) {
+        if (n < 0) {
+            //  Computed on unsigned values so that the smallest int64_t does not overflow.
+            n_sign = -1;
+            return 0ULL - (uint64_t) (int64_t) n;
+        }
+    }
+    n_sign = 1;
+    return (uint64_t) n;
+}
+
+
+bigint bigint::copy_with_carry_room() const {
+    bigint new_bigint;
+    if (values.size() > limb_vector::INLINE_CAPACITY) {
+        new_bigint.values.reserve(values.size() + 1);
+    }
+    new_bigint = *this;
+    return new_bigint;
+}
+
+
+void bigint::assign_add_small(const uint64_t& magnitude, const int8_t& add_sign) {
+    uint64_t size = values.size();
+    BIGINT_STATS_SCOPE(STATS_ADD, size + 1);
+
+    if (add_sign == sign) {
+        uint64_t carry = limbs_add_1(values.data(), values.data(), size, magnitude);
+        if (carry != 0) {
+            values.push_back(carry);
+        }
+        return;
+    }
+
+    //  The result changes sign only if the caller is a single limb smaller than magnitude.
+    if (size == 1 and values[0] < magnitude) {
+        values[0] = magnitude - values[0];
+        sign = (int8_t) -sign;
+        return;
+    }
+    limbs_sub_1(values.data(), values.data(), size, magnitude);
+    remove_empty_values();
+}
+
+
+int8_t bigint::compare_small(const uint64_t& magnitude, const int8_t& small_sign) const {
+    //  0 is positive, whatever sign it was given.
+    if (sign != small_sign and magnitude != 0) {
+        return sign;
+    }
+    if (values.size() > 1) {
+        return sign;
+    }
+    return (int8_t) (sign * compare_64(values[0], magnitude));
+}
+
+
+uint64_t bigint::divrem_small(const uint64_t& divisor) {
+    BIGINT_STATS_SCOPE(STATS_DIVIDE, values.size() + 1);
+    if (divisor == 0) {
+        throw domain_error("Division by zero.");
+    }
+    return limbs_divrem_1(values.data(), values.data(), values.size(), divisor);
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------PUBLIC METHODS AND PROCEDURES----------------------------------------
+
+//  CONSTRUCTORS
+
+bigint::bigint() : values(1, 0ULL), sign(1) {}
+
+bigint::bigint(const int64_t& initial_value) {
+    //  split_integer negates on unsigned values, which INT64_MIN needs.
+    values.push_back(split_integer(initial_value, sign));
+}
+
+bigint::bigint(const string& number_string, const uint64_t& base) {
+    assign_string(number_string, base);
+}
+
+bigint::bigint(const bigint& source_int) : values(), sign(source_int.sign) {
+    BIGINT_STATS_SCOPE(STATS_COPY, source_int.values.size());
+    values = source_int.values;
+}
+
+bigint::bigint(bigint&& source_int) noexcept : values(std::move(source_int.values)), sign(source_int.sign) {
+    source_int.values.assign(1, 0ULL);
+    source_int.sign = 1;
+}
+
+
+
+
+//  HELPER METHODS AND PROCEDURES
+
+string bigint::to_string(const uint64_t& base) const{
+    check_radix(base);
+    uint64_t size = values.size();
+    BIGINT_STATS_SCOPE(STATS_TO_STRING, size);
+    string sign_string = sign < 0 ? "-" : "";
+
+    if (size == 1 and base == 10) {
+        return sign_string + std::to_string(values[0]);
+    }
+
+    unsigned bits = radix_bits(base);
+    if (bits != 0) {
+        uint64_t digit_count = max<uint64_t>((bit_length() + bits - 1) / bits, 1);
+        string value_string(digit_count, '0');
+        limbs_to_power_of_2_radix(&value_string[0], values.data(), size, bits, digit_count);
+        return sign_string + value_string;
+    }
+
+    //  Each limb holds less than chunk.digits + 1 digits. The smallest power of 2 number of chunks that fits them all is used.
+    const radix_chunk& chunk = RADIX_CHUNKS[base];
+    uint64_t level = 0;
+    while ((chunk.digits << level) < (chunk.digits + 1) * size) {
+        level++;
+    }
+
+    //  The copy of the number, with its extra limb, and the scratch of the whole recursion share a single buffer.
+    string value_string(chunk.digits << level, '0');
+    scratch_vector scratch(size + 1 + limbs_to_radix_scratch_size(size, level, chunk), bigint_memory_resource());
+    copy(values.begin(), values.end(), scratch.begin());
+    limbs_to_radix(&value_string[0], scratch.data(), size, level, chunk, scratch.data() + size + 1);
+
+    uint64_t first_digit = value_string.find_first_not_of('0');
+    if (first_digit == string::npos) {
+        return "0";
+    }
+    value_string.erase(0, first_digit);
+    return sign_string + value_string;
+}
+
+
+int8_t bigint::compare(const bigint& second_int, bool signed_comparisson) const {
+    if (sign != second_int.sign and signed_comparisson) {
+        return sign;
+    }
+
+    uint64_t values_size = values.size();
+    uint64_t second_size = second_int.values.size();
+    if (values_size != second_size) {
+        return (int8_t) (sign * (int8_t) (values_size > second_size ? 1 : -1));
+    }
+
+    return (int8_t) (limbs_cmp(values.data(), second_int.values.data(), values_size) * sign);
+}
+
+
+
+
+//  OPERATOR OVERLOADS
+
+ostream& operator<<(ostream& os, const bigint& number) {
+    ios::fmtflags flags = os.flags();
+    ios::fmtflags base_flags = flags & ios::basefield;
+    if (base_flags != ios::hex and base_flags != ios::oct) {
+        os << number.to_string();
+        return os;
+    }
+
+    bool hex = base_flags == ios::hex;
+    string digits = number.to_string(hex ? 16 : 8);
+    string prefix = number.sign < 0 ? "-" : "";
+    if (number.sign < 0) {
+        digits.erase(0, 1);
+    }
+    //  Like for builtin integers, 0 gets no prefix.
+    if ((flags & ios::showbase) and digits != "0") {
+        prefix += hex ? "0x" : "0";
+    }
+    if (flags & ios::uppercase) {
+        transform(prefix.begin(), prefix.end(), prefix.begin(), ::toupper);
+        transform(digits.begin(), digits.end(), digits.begin(), ::toupper);
+    }
+    os << prefix + digits;
+    return os;
+}
+
+bigint& bigint::operator=(const bigint& r_value) {
+    BIGINT_STATS_SCOPE(STATS_COPY, r_value.values.size());
+    values = r_value.values;
+    sign = r_value.sign;
+    return *this;
+}
+
+bigint& bigint::operator=(bigint&& r_value) {
+    if (&r_value != this) {
+        values = std::move(r_value.values);
+        sign = r_value.sign;
+        r_value.values.assign(1, 0ULL);
+        r_value.sign = 1;
+    }
+    return *this;
+}
+
+bigint& bigint::operator=(const string& r_value) {
+    assign_string(r_value, 10);
+    return *this;
+}
+
+bool bigint::operator<(const bigint& second_int) const {
+    return compare(second_int) < 0;
+}
+
+bool bigint::operator>(const bigint& second_int) const {
+    return compare(second_int) > 0;
+}
+
+bool bigint::operator==(const bigint& second_int) const {
+    return compare(second_int) == 0;
+}
+
+bool bigint::operator<=(const bigint& second_int) const {
+    return compare(second_int) <= 0;
+}
+
+bool bigint::operator>=(const bigint& second_int) const {
+    return compare(second_int) >= 0;
+}
+
+bool bigint::operator!=(const bigint& second_int) const {
+    return compare(second_int) != 0;
+}
+
+bigint& bigint::operator+=(const bigint& second_int) {
+    assign_add(second_int, 1);
+    return *this;
+}
+
+bigint& bigint::operator-=(const bigint& second_int) {
+    assign_add(second_int, -1);
+    return *this;
+}
+
+bigint& bigint::operator*=(const bigint& second_int) {
+    uint64_t l1 = values.size(), l2 = second_int.values.size();
+    BIGINT_STATS_SCOPE(STATS_MULTIPLY, l1 + l2);
+    int8_t result_sign = (int8_t) (sign * second_int.sign);
+
+    if (&second_int != this and min(l1, l2) < KARATSUBA_THRESHOLD) {
+        /*  Schoolbook product done in place, from the most significant limb of the caller down.
+            Row i only writes to limbs i and above, and limbs below i still hold the caller's original value.
+        */
+        values.resize(l1 + l2, 0ULL);
+        const uint64_t* b = second_int.values.data();
+        for (uint64_t i = l1; i > 0; i--) {
+            uint64_t factor = values[i - 1];
+            values[i - 1] = 0ULL;
+            uint64_t carry = limbs_addmul_1(values.data() + i - 1, b, l2, factor);
+            limbs_add_1(values.data() + i - 1 + l2, values.data() + i - 1 + l2, l1 - i + 1, carry);
+        }
+    }
+    else {
+        //  Faster algorithms need the operands intact, the product goes through a scratch buffer.
+        scratch_vector product(l1 + l2, bigint_memory_resource());
+        limbs_mul(product.data(), values.data(), l1, second_int.values.data(), l2);
+        values.assign(product.data(), product.data() + l1 + l2);
+    }
+
+    sign = result_sign;
+    remove_empty_values();
+    return *this;
+}
+
+void bigint::addmul(const bigint& a, const bigint& b) {
+    assign_addmul(a, b, 1);
+}
+
+void bigint::submul(const bigint& a, const bigint& b) {
+    assign_addmul(a, b, -1);
+}
+
+void bigint::mul_small(const uint64_t& factor) {
+    BIGINT_STATS_SCOPE(STATS_MULTIPLY, values.size() + 1);
+    uint64_t carry = limbs_mul_1(values.data(), values.data(), values.size(), factor);
+    if (carry != 0) {
+        values.push_back(carry);
+    }
+    remove_empty_values();
+}
+
+bigint bigint::square() const {
+    bigint result;
+    uint64_t size = values.size();
+    BIGINT_STATS_SCOPE(STATS_MULTIPLY, 2 * size);
+    result.values.resize(2 * size);
+    limbs_sqr(result.values.data(), values.data(), size);
+    result.remove_empty_values();
+    return result;
+}
+
+uint64_t bigint::bit_length() const {
+    uint64_t size = values.size();
+    if (size == 1 and values[0] == 0) {
+        return 0;
+    }
+    return 64 * size - count_leading_zeros_64(values[size - 1]);
+}
+
+bool bigint::fits_int64() const {
+    if (values.size() > 1) {
+        return false;
+    }
+    //  -2^63 fits, 2^63 does not.
+    return sign > 0 ? values[0] <= (uint64_t) INT64_MAX : values[0] <= (1ULL << 63);
+}
+
+int64_t bigint::to_int64() const {
+    if (!fits_int64()) {
+        throw out_of_range("Value does not fit in an int64_t.");
+    }
+    return sign > 0 ? (int64_t) values[0] : (int64_t) (0ULL - values[0]);
+}
+
+bool bigint::test_bit(const uint64_t& index) const {
+    uint64_t limb_index = index / 64;
+    if (limb_index >= values.size()) {
+        return sign < 0;
+    }
+
+    uint64_t limb = values[limb_index];
+    if (sign < 0) {
+        //  ~(|x| - 1): the borrow of - 1 only reaches this limb if all the limbs below are 0.
+        bool borrow = true;
+        for (uint64_t i = 0; i < limb_index and borrow; i++) {
+            borrow = values[i] == 0;
+        }
+        limb = borrow ? ~(limb - 1) : ~limb;
+    }
+    return (limb >> (index % 64)) & 1ULL;
+}
+
+bigint bigint::operator-() const& {
+    bigint new_bigint(*this);
+    new_bigint.sign = (int8_t) -sign;
+    new_bigint.remove_empty_values();
+    return new_bigint;
+}
+
+bigint bigint::operator-() && {
+    sign = (int8_t) -sign;
+    remove_empty_values();
+    return std::move(*this);
+}
+
+bigint bigint::operator*(const bigint& second_int) const& {
+    bigint result_buffer;
+
+    uint64_t l1 = values.size(), l2 = second_int.values.size();
+    BIGINT_STATS_SCOPE(STATS_MULTIPLY, l1 + l2);
+    result_buffer.values.resize(l1 + l2);
+
+    limbs_mul(result_buffer.values.data(), values.data(), l1, second_int.values.data(), l2);
+
+    //  Compute result sign.
+    result_buffer.sign = (int8_t) (sign * second_int.sign);
+
+    //  Clean the possible 0-filled field at the front of the number.
+    result_buffer.remove_empty_values();
+    return result_buffer;
+}
+
+bigint bigint::operator*(const bigint& second_int) && {
+    *this *= second_int;
+    return std::move(*this);
+}
+
+bigint bigint::operator*(bigint&& second_int) const& {
+    second_int *= *this;
+    return std::move(second_int);
+}
+
+bigint bigint::operator*(bigint&& second_int) && {
+    *this *= second_int;
+    return std::move(*this);
+}
+
+bigint bigint::operator+(const bigint& second_int) const& {
+    //  Built from the longer operand, so that the addition only grows it for a carry.
+    if (values.size() < second_int.values.size()) {
+        bigint new_bigint = second_int.copy_with_carry_room();
+        new_bigint += *this;
+        return new_bigint;
+    }
+    bigint new_bigint = copy_with_carry_room();
+    new_bigint += second_int;
+    return new_bigint;
+}
+
+bigint bigint::operator+(const bigint& second_int) && {
+    *this += second_int;
+    return std::move(*this);
+}
+
+bigint bigint::operator+(bigint&& second_int) const& {
+    second_int += *this;
+    return std::move(second_int);
+}
+
+bigint bigint::operator+(bigint&& second_int) && {
+    *this += second_int;
+    return std::move(*this);
+}
+
+bigint bigint::operator-(const bigint& second_int) const& {
+    //  Built from the longer operand, so that the subtraction only grows it for a carry (operands of opposite signs).
+    if (values.size() < second_int.values.size()) {
+        //  a - b == -(b - a).
+        bigint new_bigint = second_int.copy_with_carry_room();
+        new_bigint -= *this;
+        new_bigint.sign = (int8_t) -new_bigint.sign;
+        new_bigint.remove_empty_values();
+        return new_bigint;
+    }
+    bigint new_bigint = copy_with_carry_room();
+    new_bigint -= second_int;
+    return new_bigint;
+}
+
+bigint bigint::operator-(const bigint& second_int) && {
+    *this -= second_int;
+    return std::move(*this);
+}
+
+bigint bigint::operator-(bigint&& second_int) const& {
+    //  a - b == -(b - a).
+    second_int -= *this;
+    second_int.sign = (int8_t) -second_int.sign;
+    second_int.remove_empty_values();
+    return std::move(second_int);
+}
+
+bigint bigint::operator-(bigint&& second_int) && {
+    *this -= second_int;
+    return std::move(*this);
+}
+
+pair<bigint, bigint> bigint::divmod(const bigint& divisor) const {
+    uint64_t l1 = values.size(), l2 = divisor.values.size();
+    BIGINT_STATS_SCOPE(STATS_DIVIDE, l1 + l2);
+    if (l2 == 1 and divisor.values[0] == 0) {
+        throw domain_error("Division by zero.");
+    }
+
+    bigint quotient, remainder;
+
+    //  |caller| < |divisor|: nothing to compute.
+    if (compare(divisor, false) * sign < 0) {
+        remainder = *this;
+        return make_pair(std::move(quotient), std::move(remainder));
+    }
+
+    quotient.values.resize(l1 - l2 + 1);
+    remainder.values.resize(l2);
+    limbs_divrem(quotient.values.data(), remainder.values.data(), values.data(), l1, divisor.values.data(), l2);
+
+    quotient.sign = (int8_t) (sign * divisor.sign);
+    remainder.sign = sign;
+    quotient.remove_empty_values();
+    remainder.remove_empty_values();
+    return make_pair(std::move(quotient), std::move(remainder));
+}
+
+bigint bigint::operator/(const bigint& divisor) const {
+    return divmod(divisor).first;
+}
+
+bigint bigint::operator%(const bigint& divisor) const {
+    return divmod(divisor).second;
+}
+
+bigint& bigint::operator/=(const bigint& divisor) {
+    *this = std::move(divmod(divisor).first);
+    return *this;
+}
+
+bigint& bigint::operator%=(const bigint& divisor) {
+    *this = std::move(divmod(divisor).second);
+    return *this;
+}
+
+bigint bigint::operator<<(const uint64_t& bits) const {
+    bigint result;
+    result.assign_shift_left(*this, bits);
+    return result;
+}
+
+bigint bigint::operator>>(const uint64_t& bits) const {
+    bigint result;
+    result.assign_shift_right(*this, bits);
+    return result;
+}
+
+bigint& bigint::operator<<=(const uint64_t& bits) {
+    assign_shift_left(*this, bits);
+    return *this;
+}
+
+bigint& bigint::operator>>=(const uint64_t& bits) {
+    assign_shift_right(*this, bits);
+    return *this;
+}
+
+bigint bigint::operator&(const bigint& second_int) const {
+    bigint result(*this);
+    result.assign_bitwise(second_int, '&');
+    return result;
+}
+
+bigint bigint::operator|(const bigint& second_int) const {
+    bigint result(*this);
+    result.assign_bitwise(second_int, '|');
+    return result;
+}
+
+bigint bigint::operator^(const bigint& second_int) const {
+    bigint result(*this);
+    result.assign_bitwise(second_int, '^');
+    return result;
+}
+
+bigint& bigint::operator&=(const bigint& second_int) {
+    assign_bitwise(second_int, '&');
+    return *this;
+}
+
+bigint& bigint::operator|=(const bigint& second_int) {
+    assign_bitwise(second_int, '|');
+    return *this;
+}
+
+bigint& bigint::operator^=(const bigint& second_int) {
+    assign_bitwise(second_int, '^');
+    return *this;
+}
+
+bigint bigint::operator~() const {
+    //  ~x = -x - 1 = -(x + 1).
+    bigint result = *this + 1;
+    result.sign = (int8_t) -result.sign;
+    result.remove_empty_values();
+    return result;
+}
+
+template<typename T, typename>
+bigint& bigint::operator+=(const T& n) {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    assign_add_small(magnitude, n_sign);
+    return *this;
+}
+
+template<typename T, typename>
+bigint& bigint::operator-=(const T& n) {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    assign_add_small(magnitude, (int8_t) -n_sign);
+    return *this;
+}
+
+template<typename T, typename>
+bigint& bigint::operator*=(const T& n) {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    sign = (int8_t) (sign * n_sign);
+    mul_small(magnitude);
+    return *this;
+}
+
+template<typename T, typename>
+bigint& bigint::operator/=(const T& n) {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    divrem_small(magnitude);
+    sign = (int8_t) (sign * n_sign);
+    remove_empty_values();
+    return *this;
+}
+
+template<typename T, typename>
+bigint& bigint::operator%=(const T& n) {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    //  The remainder keeps the sign of the caller.
+    uint64_t remainder = divrem_small(magnitude);
+    values.assign(1, remainder);
+    remove_empty_values();
+    return *this;
+}
+
+template<typename T, typename>
+bigint bigint::operator+(const T& n) const& {
+    bigint new_bigint = copy_with_carry_room();
+    new_bigint += n;
+    return new_bigint;
+}
+
+template<typename T, typename>
+bigint bigint::operator+(const T& n) && {
+    *this += n;
+    return std::move(*this);
+}
+
+template<typename T, typename>
+bigint bigint::operator-(const T& n) const& {
+    bigint new_bigint = copy_with_carry_room();
+    new_bigint -= n;
+    return new_bigint;
+}
+
+template<typename T, typename>
+bigint bigint::operator-(const T& n) && {
+    *this -= n;
+    return std::move(*this);
+}
+
+template<typename T, typename>
+bigint bigint::operator*(const T& n) const& {
+    bigint new_bigint = copy_with_carry_room();
+    new_bigint *= n;
+    return new_bigint;
+}
+
+template<typename T, typename>
+bigint bigint::operator*(const T& n) && {
+    *this *= n;
+    return std::move(*this);
+}
+
+template<typename T, typename>
+bigint bigint::operator/(const T& n) const& {
+    bigint new_bigint(*this);
+    new_bigint /= n;
+    return new_bigint;
+}
+
+template<typename T, typename>
+bigint bigint::operator/(const T& n) && {
+    *this /= n;
+    return std::move(*this);
+}
+
+template<typename T, typename>
+bigint bigint::operator%(const T& n) const& {
+    //  Only the remainder is kept, the quotient is not worth a copy of the caller.
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    if (magnitude == 0) {
+        throw domain_error("Division by zero.");
+    }
+    BIGINT_STATS_SCOPE(STATS_DIVIDE, values.size() + 1);
+    bigint remainder;
+    remainder.values[0] = limbs_mod_1(values.data(), values.size(), magnitude);
+    remainder.sign = sign;
+    remainder.remove_empty_values();
+    return remainder;
+}
+
+template<typename T, typename>
+bigint bigint::operator%(const T& n) && {
+    *this %= n;
+    return std::move(*this);
+}
+
+template<typename T, typename>
+bool bigint::operator<(const T& n) const {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    return compare_small(magnitude, n_sign) < 0;
+}
+
+template<typename T, typename>
+bool bigint::operator>(const T& n) const {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    return compare_small(magnitude, n_sign) > 0;
+}
+
+template<typename T, typename>
+bool bigint::operator==(const T& n) const {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    return compare_small(magnitude, n_sign) == 0;
+}
+
+template<typename T, typename>
+bool bigint::operator<=(const T& n) const {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    return compare_small(magnitude, n_sign) <= 0;
+}
+
+template<typename T, typename>
+bool bigint::operator>=(const T& n) const {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    return compare_small(magnitude, n_sign) >= 0;
+}
+
+template<typename T, typename>
+bool bigint::operator!=(const T& n) const {
+    int8_t n_sign;
+    uint64_t magnitude = split_integer(n, n_sign);
+    return compare_small(magnitude, n_sign) != 0;
+}
+
+template<typename T, typename>
+bigint operator+(const T& n, const bigint& number) {
+    return number + n;
+}
+
+template<typename T, typename>
+bigint operator-(const T& n, const bigint& number) {
+    //  n - x == -(x - n).
+    return -(number - n);
+}
+
+template<typename T, typename>
+bigint operator*(const T& n, const bigint& number) {
+    return number * n;
+}
+
+template<typename T, typename>
+bool operator<(const T& n, const bigint& number) {
+    return number > n;
+}
+
+template<typename T, typename>
+bool operator>(const T& n, const bigint& number) {
+    return number < n;
+}
+
+template<typename T, typename>
+bool operator==(const T& n, const bigint& number) {
+    //  Named explicitly, as C++20 would also consider this very function with its arguments reversed.
+    return number.operator==(n);
+}
+
+template<typename T, typename>
+bool operator<=(const T& n, const bigint& number) {
+    return number >= n;
+}
+
+template<typename T, typename>
+bool operator>=(const T& n, const bigint& number) {
+    return number <= n;
+}
+
+template<typename T, typename>
+bool operator!=(const T& n, const bigint& number) {
+    return number.operator!=(n);
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------MODULAR EXPONENTIATION----------------------------------------
+
+/*  Montgomery's representation stores x mod n as x * R mod n, with R = 2^(64 * size) > n. The product of two
+    such values only needs to be divided by R, which unlike a division by n can be done exactly by adding the
+    right multiple of n (the one that zeroes the low half) and dropping the low half. n has to be odd for that
+    multiple to exist.
+*/
+
+/**
+ * @brief   Size (in limbs) of the modulus from which Montgomery reductions are done with two full products
+ *          instead of limb by limb. Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t MONTGOMERY_REDC_THRESHOLD = 112;
+
+
+/**
+ * @brief Returns the inverse of an odd a modulo 2^64, by Newton iteration (each step doubles the number of correct bits).
+ * 
+ * @param a 
+ * @return uint64_t 
+ */
+static uint64_t inverse_64(const uint64_t& a) {
+    //  a * a == 1 mod 8 for any odd a, which gives the first 3 bits.
+    uint64_t inverse = a;
+    for (int i = 0; i < 5; i++) {
+        inverse *= 2 - a * inverse;
+    }
+    return inverse;
+}
+
+
+/**
+ * @brief   Picks the sliding window size for an exponent of the given bit length, by minimizing the number of
+ *          products: 2^(w - 1) to build the table plus about one every w + 1 bits.
+ * 
+ * @param bits 
+ * @return uint64_t 
+ */
+static uint64_t powmod_window_size(const uint64_t& bits) {
+    uint64_t best = 1;
+    for (uint64_t w = 2; w <= 8; w++) {
+        if ((1ULL << (w - 1)) + bits / (w + 1) < (1ULL << (best - 1)) + bits / (best + 1)) {
+            best = w;
+        }
+    }
+    return best;
+}
+
+
+/**
+ * @brief Returns bit index of the limb array a.
+ * 
+ * @param a 
+ * @param index 
+ * @return bool 
+ */
+static bool limbs_test_bit(const uint64_t* a, const uint64_t& index) {
+    return (a[index / 64] >> (index % 64)) & 1ULL;
+}
+
+
+montgomery_context::montgomery_context(const bigint& modulus) : modulus_value(modulus), size(modulus.values.size()) {
+    if (modulus.sign < 0 or (modulus.values[0] & 1ULL) == 0) {
+        throw domain_error("Montgomery modulus must be odd and positive.");
+    }
+    const uint64_t* n = modulus.values.data();
+
+    /*  -1 / n mod R, limb by limb: each limb is chosen so that adding the corresponding multiple of n
+        zeroes the next limb of the running sum, exactly like reduce() does.
+    */
+    uint64_t n_inverse = -inverse_64(n[0]);
+    modulus_inverse.assign(size, 0ULL);
+    vector<uint64_t> sum(size + 1, 0ULL);
+    sum[0] = 1ULL;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t m = sum[i] * n_inverse;
+        modulus_inverse[i] = m;
+        limbs_addmul_1(sum.data() + i, n, size - i, m);
+    }
+
+    //  R^2 mod n, from a division of R^2 by n.
+    vector<uint64_t> r_power(2 * size + 1, 0ULL), quotient(size + 2);
+    r_power[2 * size] = 1ULL;
+    r_squared.resize(size);
+    limbs_divrem(quotient.data(), r_squared.data(), r_power.data(), 2 * size + 1, n, size);
+}
+
+const bigint& montgomery_context::modulus() const {
+    return modulus_value;
+}
+
+void montgomery_context::reduce(uint64_t* result, uint64_t* t, uint64_t* scratch) const {
+    const uint64_t* n = modulus_value.values.data();
+
+    if (size < MONTGOMERY_REDC_THRESHOLD) {
+        //  One limb at a time: adding m * n with m = t[i] * (-1 / n) mod 2^64 zeroes limb i.
+        for (uint64_t i = 0; i < size; i++) {
+            uint64_t carry = limbs_addmul_1(t + i, n, size, t[i] * modulus_inverse[0]);
+            limbs_add_1(t + i + size, t + i + size, size + 1 - i, carry);
+        }
+    }
+    else {
+        //  All limbs at once: m = (t mod R) * (-1 / n) mod R, then t + m * n is a multiple of R.
+        limbs_mul(scratch, t, size, modulus_inverse.data(), size);
+        limbs_mul(scratch + 2 * size, scratch, size, n, size);
+        t[2 * size] += limbs_add_n(t, t, scratch + 2 * size, 2 * size);
+    }
+
+    //  t / R < 2n, at most one substraction is needed.
+    uint64_t* high = t + size;
+    if (high[size] != 0 or limbs_cmp(high, n, size) >= 0) {
+        limbs_sub_n(result, high, n, size);
+    }
+    else {
+        copy(high, high + size, result);
+    }
+}
+
+void montgomery_context::multiply(uint64_t* result, const uint64_t* a, const uint64_t* b, uint64_t* t, uint64_t* scratch) const {
+    limbs_mul(t, a, size, b, size);
+    t[2 * size] = 0ULL;
+    reduce(result, t, scratch);
+}
+
+bigint montgomery_context::powmod(const bigint& base, const bigint& exponent) const {
+    if (exponent.sign < 0) {
+        throw domain_error("Negative exponent.");
+    }
+
+    if (exponent.values.size() == 1 and exponent.values[0] == 0) {
+        //  x^0 is 1, which is 0 modulo 1.
+        return modulus_value == bigint(1) ? bigint(0) : bigint(1);
+    }
+
+    bigint reduced_base = base % modulus_value;
+    if (reduced_base.sign < 0) {
+        reduced_base += modulus_value;
+    }
+
+    uint64_t bits = 64 * exponent.values.size() - count_leading_zeros_64(exponent.values.back());
+    uint64_t window = powmod_window_size(bits);
+    const uint64_t* e = exponent.values.data();
+
+    /*  All buffers are allocated upfront: the table of odd powers base^1, base^3 ... base^(2^window - 1),
+        the accumulator, the base squared, a product and the reduction scratch.
+    */
+    uint64_t table_size = 1ULL << (window - 1);
+    scratch_vector buffer((table_size + 8) * size + 1, 0ULL, bigint_memory_resource());
+    uint64_t* table = buffer.data();
+    uint64_t* accumulator = table + table_size * size;
+    uint64_t* square = accumulator + size;
+    uint64_t* t = square + size;
+    uint64_t* scratch = t + 2 * size + 1;
+    bigint result;
+    result.values.reserve(size);
+
+    //  Products above the basecase threshold need scratch space of their own, which comes from an arena reset after each use.
+    bigint_arena arena(16 * size * sizeof(uint64_t) + 4096);
+    bigint_resource_scope scope(&arena);
+
+    copy(reduced_base.values.begin(), reduced_base.values.end(), accumulator);
+    multiply(table, accumulator, r_squared.data(), t, scratch);
+    multiply(square, table, table, t, scratch);
+    for (uint64_t i = 1; i < table_size; i++) {
+        multiply(table + i * size, table + (i - 1) * size, square, t, scratch);
+        arena.reset();
+    }
+
+    //  Left to right: zeros cost one squaring each, otherwise the longest window ending with a 1 is taken at once.
+    bool started = false;
+    uint64_t i = bits;
+    while (i > 0) {
+        if (not limbs_test_bit(e, i - 1)) {
+            multiply(accumulator, accumulator, accumulator, t, scratch);
+            arena.reset();
+            i--;
+            continue;
+        }
+
+        uint64_t low = i > window ? i - window : 0;
+        while (not limbs_test_bit(e, low)) {
+            low++;
+        }
+        uint64_t value = 0;
+        for (uint64_t j = i; j > low; j--) {
+            value = 2 * value + limbs_test_bit(e, j - 1);
+        }
+
+        if (started) {
+            for (uint64_t j = low; j < i; j++) {
+                multiply(accumulator, accumulator, accumulator, t, scratch);
+                arena.reset();
+            }
+            multiply(accumulator, accumulator, table + (value / 2) * size, t, scratch);
+            arena.reset();
+        }
+        else {
+            copy(table + (value / 2) * size, table + (value / 2 + 1) * size, accumulator);
+            started = true;
+        }
+        i = low;
+    }
+
+    //  Back from Montgomery form: one more reduction.
+    fill(t, t + 2 * size + 1, 0ULL);
+    copy(accumulator, accumulator + size, t);
+    reduce(accumulator, t, scratch);
+    arena.reset();
+
+    result.values.assign(accumulator, accumulator + size);
+    result.remove_empty_values();
+    return result;
+}
+
+bigint powmod(const bigint& base, const bigint& exponent, const bigint& modulus) {
+    if (modulus.sign < 0 or (modulus.values.size() == 1 and modulus.values[0] == 0)) {
+        throw domain_error("Modulus must be positive.");
+    }
+
+    if (modulus.values[0] & 1ULL) {
+        return montgomery_context(modulus).powmod(base, exponent);
+    }
+
+    //  Even moduli cannot use Montgomery's representation, products are reduced by divisions.
+    if (exponent.sign < 0) {
+        throw domain_error("Negative exponent.");
+    }
+    bigint power = base % modulus;
+    if (power.sign < 0) {
+        power += modulus;
+    }
+
+    bigint result = 1;
+    result %= modulus;
+    for (uint64_t i = 64 * exponent.values.size(); i > 0; i--) {
+        result *= result;
+        result %= modulus;
+        if (limbs_test_bit(exponent.values.data(), i - 1)) {
+            result *= power;
+            result %= modulus;
+        }
+    }
+    return result;
+}
+
+bigint pow(const bigint& base, const uint64_t& exponent) {
+    bigint result = 1;
+    if (exponent == 0) {
+        return result;
+    }
+
+    //  Left to right binary exponentiation, squaring in place.
+    result = base;
+    for (int bit = 62 - (int) count_leading_zeros_64(exponent); bit >= 0; bit--) {
+        result *= result;
+        if ((exponent >> bit) & 1ULL) {
+            result *= base;
+        }
+    }
+    return result;
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------GCD----------------------------------------
+
+/*  Greatest common divisors are computed with Euclid's algorithm, finding the quotients in batches.
+    The quotients of a batch are kept in a 2 x 2 matrix M such that (a, b) = M (alpha, beta), where
+    (alpha, beta) is the reduced pair. Each quotient q multiplies M by [q 1; 1 0] on the right, so M has
+    non-negative entries and determinant (-1)^(number of quotients).
+
+    Quotients found from the most significant bits of a and b are also the quotients of a and b themselves
+    if, m being the largest entry of M, the reduced top bits satisfy beta >= m and alpha - beta >= 2m.
+    The error made on each reduced value by ignoring the low bits is then too small to change their order.
+    - Lehmer's algorithm finds a batch from the two most significant limbs (a double limb) of a and b,
+      with single limb entries, and applies it to a and b with single limb products.
+    - Above GCD_HGCD_THRESHOLD limbs, the half-gcd algorithm finds a batch that halves the most significant
+      half of a and b, recursively from the most significant half of that half, and applies it with fast
+      products. This makes the whole gcd cost O(M(n) log(n)).
+
+    Values are kept in scratch_vectors without leading 0s, zero being a single 0 limb.
+*/
+
+/**
+ * @brief   Size (in limbs) from which the half-gcd algorithm recurses instead of using Lehmer steps.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t HGCD_THRESHOLD = 100;
+
+/**
+ * @brief   Size (in limbs) from which gcds are reduced with the half-gcd algorithm instead of Lehmer's.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t GCD_HGCD_THRESHOLD = 4000;
+
+#if defined(__SIZEOF_INT128__)
+//  Lehmer steps work on double limbs, and find single limb entries.
+typedef unsigned __int128 lehmer_digit;
+static const uint64_t LEHMER_BITS = 128;
+static const lehmer_digit LEHMER_ENTRY_LIMIT = UINT64_MAX;
+#else
+//  Without a 128 bits type, Lehmer steps work on single limbs and find half limb entries.
+typedef uint64_t lehmer_digit;
+static const uint64_t LEHMER_BITS = 64;
+static const lehmer_digit LEHMER_ENTRY_LIMIT = UINT64_MAX / 2;
+#endif
+
+
+/**
+ * @brief   Matrix of a batch of Euclid quotients. Each row is only kept up to date if asked for: a gcd alone
+ *          needs none, an extended gcd only needs the second one.
+ * 
+ */
+struct gcd_matrix {
+    scratch_vector m00, m01, m10, m11;
+    bool odd;
+    bool first_row;
+    bool second_row;
+
+    /**
+     * @brief Construct an identity matrix.
+     * 
+     * @param track_first_row 
+     * @param track_second_row 
+     */
+    gcd_matrix(const bool& track_first_row, const bool& track_second_row)
+        : m00(1, 1ULL, bigint_memory_resource()), m01(1, 0ULL, bigint_memory_resource()), m10(1, 0ULL, bigint_memory_resource()),
+          m11(1, 1ULL, bigint_memory_resource()), odd(false), first_row(track_first_row), second_row(track_second_row) {}
+
+    gcd_matrix(const gcd_matrix& other) = delete;
+    gcd_matrix& operator=(const gcd_matrix& other) = delete;
+
+    void swap(gcd_matrix& other) {
+        m00.swap(other.m00);
+        m01.swap(other.m01);
+        m10.swap(other.m10);
+        m11.swap(other.m11);
+        std::swap(odd, other.odd);
+    }
+};
+
+
+/**
+ * @brief Quotients found by a Lehmer step: the reduced pair is (s0 a - t0 b, t1 b - s1 a), up to the sign.
+ * 
+ */
+struct lehmer_batch {
+    uint64_t s0, t0, s1, t1;
+    uint64_t steps;
+};
+
+
+/**
+ * @brief Returns a value of size limbs, all 0.
+ * 
+ * @param size 
+ * @return scratch_vector 
+ */
+static scratch_vector gcd_value(const uint64_t& size) {
+    return scratch_vector(size, 0ULL, bigint_memory_resource());
+}
+
+
+/**
+ * @brief Removes the 0s at the front of a value, keeping at least one limb.
+ * 
+ * @param a 
+ */
+static void gcd_trim(scratch_vector& a) {
+    uint64_t size = limbs_normalized_size(a.data(), a.size());
+    a.resize(size > 0 ? size : 1);
+}
+
+
+static bool gcd_is_zero(const scratch_vector& a) {
+    return a.size() == 1 and a[0] == 0;
+}
+
+
+static int gcd_cmp(const scratch_vector& a, const scratch_vector& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    return limbs_cmp(a.data(), b.data(), a.size());
+}
+
+
+/**
+ * @brief Computes result = u * x + v * y for single limbs u and v. result must not be x or y.
+ * 
+ * @param result 
+ * @param x 
+ * @param u 
+ * @param y 
+ * @param v 
+ */
+static void gcd_combine_1(scratch_vector& result, const scratch_vector& x, const uint64_t& u, const scratch_vector& y, const uint64_t& v) {
+    const scratch_vector& large = x.size() >= y.size() ? x : y;
+    const scratch_vector& small = x.size() >= y.size() ? y : x;
+    uint64_t large_factor = x.size() >= y.size() ? u : v, small_factor = x.size() >= y.size() ? v : u;
+
+    result.assign(large.size() + 1, 0ULL);
+    result[large.size()] = limbs_mul_1(result.data(), large.data(), large.size(), large_factor);
+    uint64_t carry = limbs_addmul_1(result.data(), small.data(), small.size(), small_factor);
+    limbs_add_1(result.data() + small.size(), result.data() + small.size(), large.size() + 1 - small.size(), carry);
+    gcd_trim(result);
+}
+
+
+/**
+ * @brief Computes result = u * x - v * y for single limbs u and v. The difference must not be negative.
+ *          result must not be x or y.
+ * 
+ * @param result 
+ * @param x 
+ * @param u 
+ * @param y 
+ * @param v 
+ */
+static void gcd_difference_1(scratch_vector& result, const scratch_vector& x, const uint64_t& u, const scratch_vector& y, const uint64_t& v) {
+    uint64_t size = max(x.size(), y.size()) + 1;
+    result.assign(size, 0ULL);
+    result[x.size()] = limbs_mul_1(result.data(), x.data(), x.size(), u);
+    uint64_t borrow = limbs_submul_1(result.data(), y.data(), y.size(), v);
+    limbs_sub_1(result.data() + y.size(), result.data() + y.size(), size - y.size(), borrow);
+    gcd_trim(result);
+}
+
+
+/**
+ * @brief Computes result = x * u + y * v, or x * u - y * v if subtract is set (it must not be negative).
+ * 
+ * @param result 
+ * @param x 
+ * @param u 
+ * @param y 
+ * @param v 
+ * @param subtract 
+ */
+static void gcd_combine(scratch_vector& result, const scratch_vector& x, const scratch_vector& u,
+                        const scratch_vector& y, const scratch_vector& v, const bool& subtract) {
+    scratch_vector second = gcd_value(y.size() + v.size());
+    result.assign(max(x.size() + u.size(), y.size() + v.size()) + 1, 0ULL);
+    limbs_mul(result.data(), x.data(), x.size(), u.data(), u.size());
+    limbs_mul(second.data(), y.data(), y.size(), v.data(), v.size());
+    if (subtract) {
+        limbs_sub(result.data(), result.data(), result.size(), second.data(), second.size());
+    }
+    else {
+        limbs_add(result.data(), result.data(), result.size(), second.data(), second.size());
+    }
+    gcd_trim(result);
+}
+
+
+/**
+ * @brief   Returns the bits of a from bit shift up, as a lehmer_digit. a must have at most LEHMER_BITS bits above shift.
+ * 
+ * @param a 
+ * @param shift 
+ * @return lehmer_digit 
+ */
+static lehmer_digit lehmer_top_digit(const scratch_vector& a, const uint64_t& shift) {
+    lehmer_digit digit = 0;
+    unsigned bits = shift % 64;
+    uint64_t position = 0;
+    for (uint64_t i = shift / 64; i < a.size() and position < LEHMER_BITS; i++, position += 64) {
+        uint64_t limb = a[i] >> bits;
+        if (bits != 0 and i + 1 < a.size()) {
+            limb |= a[i + 1] << (64 - bits);
+        }
+        digit |= (lehmer_digit) limb << position;
+    }
+    return digit;
+}
+
+
+/**
+ * @brief   Finds up to max_steps quotients of a by b (a >= b) from their most significant LEHMER_BITS bits.
+ *          Returns the number found, which is 0 when b is much smaller than a or the first quotient is too large.
+ * 
+ * @param a 
+ * @param b 
+ * @param max_steps 
+ * @param batch 
+ * @return uint64_t 
+ */
+static uint64_t lehmer_find(const scratch_vector& a, const scratch_vector& b, const uint64_t& max_steps, lehmer_batch& batch) {
+    uint64_t bits = 64 * a.size() - count_leading_zeros_64(a.back());
+    uint64_t shift = bits > LEHMER_BITS ? bits - LEHMER_BITS : 0;
+    lehmer_digit x = lehmer_top_digit(a, shift), y = lehmer_top_digit(b, shift);
+
+    //  x_i = (-1)^i (s_i x - t_i y), and the batch matrix is [t_i+1 t_i; s_i+1 s_i].
+    lehmer_digit s0 = 1, t0 = 0, s1 = 0, t1 = 1;
+    uint64_t steps = 0;
+    while (steps < max_steps and y != 0) {
+        lehmer_digit q = x / y;
+        lehmer_digit r = x - q * y;
+        if ((s1 != 0 and q > (LEHMER_ENTRY_LIMIT - s0) / s1) or q > (LEHMER_ENTRY_LIMIT - t0) / t1) {
+            break;
+        }
+        lehmer_digit s2 = s0 + q * s1, t2 = t0 + q * t1;
+        lehmer_digit largest = max(s2, t2);
+        if (r < largest or y - r < 2 * largest) {
+            break;
+        }
+        x = y;
+        y = r;
+        s0 = s1;
+        s1 = s2;
+        t0 = t1;
+        t1 = t2;
+        steps++;
+    }
+
+    batch.s0 = (uint64_t) s0;
+    batch.t0 = (uint64_t) t0;
+    batch.s1 = (uint64_t) s1;
+    batch.t1 = (uint64_t) t1;
+    batch.steps = steps;
+    return steps;
+}
+
+
+/**
+ * @brief Applies a Lehmer batch to (a, b), the result going to (new_a, new_b).
+ * 
+ * @param a 
+ * @param b 
+ * @param batch 
+ * @param new_a 
+ * @param new_b 
+ */
+static void lehmer_reduce(const scratch_vector& a, const scratch_vector& b, const lehmer_batch& batch, scratch_vector& new_a, scratch_vector& new_b) {
+    if (batch.steps % 2 == 0) {
+        gcd_difference_1(new_a, a, batch.s0, b, batch.t0);
+        gcd_difference_1(new_b, b, batch.t1, a, batch.s1);
+    }
+    else {
+        gcd_difference_1(new_a, b, batch.t0, a, batch.s0);
+        gcd_difference_1(new_b, a, batch.s1, b, batch.t1);
+    }
+}
 
 
-//  ----------------------------------------STATIC FUNCTIONS----------------------------------------
+/**
+ * @brief Multiplies matrix by the matrix [t1 t0; s1 s0] of a Lehmer batch on the right, the result going to new_matrix.
+ * 
+ * @param matrix 
+ * @param batch 
+ * @param new_matrix 
+ */
+static void lehmer_matrix_update(const gcd_matrix& matrix, const lehmer_batch& batch, gcd_matrix& new_matrix) {
+    if (matrix.first_row) {
+        gcd_combine_1(new_matrix.m00, matrix.m00, batch.t1, matrix.m01, batch.s1);
+        gcd_combine_1(new_matrix.m01, matrix.m00, batch.t0, matrix.m01, batch.s0);
+    }
+    if (matrix.second_row) {
+        gcd_combine_1(new_matrix.m10, matrix.m10, batch.t1, matrix.m11, batch.s1);
+        gcd_combine_1(new_matrix.m11, matrix.m10, batch.t0, matrix.m11, batch.s0);
+    }
+    new_matrix.odd = matrix.odd != (batch.steps % 2 == 1);
+}
+
+
+/**
+ * @brief   Performs a single Euclid step with a full division: (new_a, new_b) = (b, a mod b) and new_matrix is
+ *          matrix multiplied by [q 1; 1 0] on the right. b must not be 0.
+ * 
+ * @param a 
+ * @param b 
+ * @param matrix 
+ * @param new_a 
+ * @param new_b 
+ * @param new_matrix 
+ */
+static void gcd_division_step(const scratch_vector& a, const scratch_vector& b, const gcd_matrix& matrix,
+                              scratch_vector& new_a, scratch_vector& new_b, gcd_matrix& new_matrix) {
+    scratch_vector quotient = gcd_value(a.size() - b.size() + 1);
+    new_b.assign(b.size(), 0ULL);
+    limbs_divrem(quotient.data(), new_b.data(), a.data(), a.size(), b.data(), b.size());
+    gcd_trim(quotient);
+    gcd_trim(new_b);
+    new_a = b;
+
+    //  Each row (x, y) becomes (x q + y, x).
+    scratch_vector one = gcd_value(1);
+    one[0] = 1ULL;
+    if (matrix.first_row) {
+        gcd_combine(new_matrix.m00, matrix.m00, quotient, matrix.m01, one, false);
+        new_matrix.m01 = matrix.m00;
+    }
+    if (matrix.second_row) {
+        gcd_combine(new_matrix.m10, matrix.m10, quotient, matrix.m11, one, false);
+        new_matrix.m11 = matrix.m10;
+    }
+    new_matrix.odd = not matrix.odd;
+}
+
 
 /**
- * @brief Constant used for computations by blocs of ~32 bits. Bad practice but computing it everytime would be a waste.
+ * @brief Multiplies matrix by other (which has both rows) on the right, the result going to new_matrix.
  * 
+ * @param matrix 
+ * @param other 
+ * @param new_matrix 
  */
-static const uint64_t STEP_32 = (uint64_t) log10(UINT32_MAX) - 1;
+static void gcd_matrix_multiply(const gcd_matrix& matrix, const gcd_matrix& other, gcd_matrix& new_matrix) {
+    if (matrix.first_row) {
+        gcd_combine(new_matrix.m00, matrix.m00, other.m00, matrix.m01, other.m10, false);
+        gcd_combine(new_matrix.m01, matrix.m00, other.m01, matrix.m01, other.m11, false);
+    }
+    if (matrix.second_row) {
+        gcd_combine(new_matrix.m10, matrix.m10, other.m00, matrix.m11, other.m10, false);
+        gcd_combine(new_matrix.m11, matrix.m10, other.m01, matrix.m11, other.m11, false);
+    }
+    new_matrix.odd = matrix.odd != other.odd;
+}
 
 
 /**
- * @brief Performs the a + b addition while checking for overflow. Carry is set to 1 if overflow occurs, 0 else.
+ * @brief   Computes (new_a, new_b) = M^-1 (a, b), M having both rows. The quotients of M must be quotients of a by b,
+ *          which is the case if they were found from the top bits of a and b and can be lifted (see gcd_liftable).
  * 
  * @param a 
  * @param b 
- * @param carry 
- * @return uint64_t 
+ * @param matrix 
+ * @param new_a 
+ * @param new_b 
  */
-static uint64_t add_check_overflow(const uint64_t& a, const uint64_t& b, uint64_t& carry) {
-    uint64_t result = a + b;
-    carry = result < a ? 1 : 0;
-    return result;
+static void gcd_matrix_reduce(const scratch_vector& a, const scratch_vector& b, const gcd_matrix& matrix, scratch_vector& new_a, scratch_vector& new_b) {
+    //  M^-1 = [m11 -m01; -m10 m00] / det(M), with det(M) = -1 for an odd number of quotients.
+    if (matrix.odd) {
+        gcd_combine(new_a, b, matrix.m01, a, matrix.m11, true);
+        gcd_combine(new_b, a, matrix.m10, b, matrix.m00, true);
+    }
+    else {
+        gcd_combine(new_a, a, matrix.m11, b, matrix.m01, true);
+        gcd_combine(new_b, b, matrix.m00, a, matrix.m10, true);
+    }
 }
 
 
 /**
- * @brief   Power function that uses uint64_t variables internally. Does not check for overflow.
- *          Very inneficient, needs to be optimized later.
+ * @brief   Whether the reduced pair (a, b) obtained with matrix is far enough from its neighbours for the quotients of
+ *          matrix to also be correct for any number whose top bits are the unreduced pair: b >= m and a - b >= 2m,
+ *          m being the largest entry of matrix, which is always m00.
  * 
- * @param base 
- * @param exp 
- * @return uint64_t 
+ * @param a 
+ * @param b 
+ * @param matrix Must have both rows.
+ * @return bool 
  */
-static uint64_t pow_64(const uint64_t& base, const uint64_t& exp) {
-    uint64_t res = 1;
-    for (uint64_t i = 0; i < exp; i++) {
-        res *= base;
+static bool gcd_liftable(const scratch_vector& a, const scratch_vector& b, const gcd_matrix& matrix) {
+    const scratch_vector& largest = matrix.m00;
+    if (gcd_cmp(b, largest) < 0 or gcd_cmp(a, b) <= 0) {
+        return false;
     }
-    return res;
+
+    //  a - b >= 2m is checked as (a - b) / 2 >= m.
+    uint64_t size = a.size();
+    scratch_vector difference = gcd_value(size);
+    limbs_sub(difference.data(), a.data(), size, b.data(), b.size());
+    limbs_rshift(difference.data(), difference.data(), size, 1);
+    gcd_trim(difference);
+    return gcd_cmp(difference, largest) >= 0;
 }
 
 
 /**
- * @brief Removes unnecessary 0s at the beginning of a string of digits representing a number.
+ * @brief   Reduces (a, b) with Lehmer steps, or single division steps, for as long as the result stays liftable.
+ *          matrix must have both rows and is multiplied by the quotients found.
  * 
- * @param number 
+ * @param a 
+ * @param b 
+ * @param matrix 
+ * @return bool Whether any quotient was found.
  */
-static void truncate_0s(string& number) {
-    while (number[0] == '0') {
-        number.erase(0, 1);
+static bool hgcd_lehmer(scratch_vector& a, scratch_vector& b, gcd_matrix& matrix) {
+    bool found = false;
+    uint64_t max_steps = UINT64_MAX;
+    scratch_vector new_a = gcd_value(1), new_b = gcd_value(1);
+    gcd_matrix new_matrix(true, true);
+
+    while (not gcd_is_zero(b)) {
+        lehmer_batch batch;
+        if (lehmer_find(a, b, max_steps, batch) > 0) {
+            lehmer_reduce(a, b, batch, new_a, new_b);
+            lehmer_matrix_update(matrix, batch, new_matrix);
+        }
+        else {
+            gcd_division_step(a, b, matrix, new_a, new_b, new_matrix);
+        }
+
+        if (gcd_liftable(new_a, new_b, new_matrix)) {
+            a.swap(new_a);
+            b.swap(new_b);
+            matrix.swap(new_matrix);
+            found = true;
+            max_steps = UINT64_MAX;
+        }
+        else if (batch.steps > 1) {
+            //  The end is within this batch: retry with fewer quotients.
+            max_steps = batch.steps / 2;
+        }
+        else {
+            break;
+        }
     }
+    return found;
 }
 
 
 /**
- * @brief Adds unnecessary 0s at the beginning of a string of digits representing a number.
+ * @brief Returns the value of a without its size least significant limbs.
  * 
- * @param number String of digits to modify.
- * @param n_0s Number of 0s to add.
+ * @param a 
+ * @param size 
+ * @return scratch_vector 
  */
-static void add_0s(string& number, const uint64_t& n_0s) {
-    for (uint64_t i = 0; i < n_0s; i++) {
-        number = "0" + number;
+static scratch_vector gcd_high_part(const scratch_vector& a, const uint64_t& size) {
+    if (a.size() <= size) {
+        return gcd_value(1);
     }
+    scratch_vector high(a.begin() + size, a.end(), bigint_memory_resource());
+    return high;
 }
 
 
+static bool hgcd(scratch_vector& a, scratch_vector& b, gcd_matrix& matrix);
+
 /**
- * @brief Divides the provided number by 2^32 and returns the remainder.
+ * @brief   Tries to reduce (a, b) with the quotients that the top parts of a and b above split limbs lead to.
+ *          They are kept if the result is liftable once combined with matrix.
  * 
- * @param number A digit string representing the input number.
- * @param result A digit string representing the result. Will be overwritten by the function.
- * @return uint64_t Remainder.
+ * @param a 
+ * @param b 
+ * @param split 
+ * @param matrix 
+ * @return bool Whether any quotient was kept.
  */
-static uint64_t string_euclid_32(const string& number, string& result) {
+static bool hgcd_top(scratch_vector& a, scratch_vector& b, const uint64_t& split, gcd_matrix& matrix) {
+    scratch_vector high_a = gcd_high_part(a, split), high_b = gcd_high_part(b, split);
+    gcd_matrix top_matrix(true, true);
+    if (not hgcd(high_a, high_b, top_matrix)) {
+        return false;
+    }
 
-    result = "";
-    if (number == "") {
-        return 0;
+    scratch_vector new_a = gcd_value(1), new_b = gcd_value(1);
+    gcd_matrix new_matrix(true, true);
+    gcd_matrix_reduce(a, b, top_matrix, new_a, new_b);
+    gcd_matrix_multiply(matrix, top_matrix, new_matrix);
+    if (not gcd_liftable(new_a, new_b, new_matrix)) {
+        return false;
     }
+    a.swap(new_a);
+    b.swap(new_b);
+    matrix.swap(new_matrix);
+    return true;
+}
 
-    size_t len = number.size();
-    uint64_t remainder = 0;
-    uint64_t j = 0;
 
-    for (uint64_t i = 1; i <= len; i++) {
+/**
+ * @brief   Half-gcd: reduces (a, b) in place to about half the size of a, with a liftable result. matrix must be the
+ *          identity with both rows, it receives the quotients found.
+ * 
+ * @param a 
+ * @param b 
+ * @param matrix 
+ * @return bool Whether any quotient was found.
+ */
+static bool hgcd(scratch_vector& a, scratch_vector& b, gcd_matrix& matrix) {
+    uint64_t size = a.size();
+    bool found = false;
 
-        /*  The divisions are made by "blocs" of just under 32 bits.
-            This guarantees that a possible large remainder of a previous division concatenated to the new
-            dividend will not exceed 64 bits.
-            Better efficiency could be achieved using the special 128 or even 512 bits instructions but old computers
-            can't always do that.
-        */ 
-        if ((i - j > STEP_32) or (i == len)) {
+    if (size >= HGCD_THRESHOLD) {
+        //  The top half reduced to a quarter leaves (a, b) at about three quarters of size.
+        found = hgcd_top(a, b, size / 2, matrix);
 
-            remainder *= pow_64(10, i - j);
-            remainder += stoull(number.substr(j, i - j));
-            string quotient = to_string(remainder / 0x100000000ULL);
+        /*  Splitting there so that the top part is reduced to half the original size. Only when the first step made
+            progress, and never on more than size / 2 limbs: otherwise the split falls near the bottom of a, and
+            recursing on almost all of it makes the recursion exponential on inputs such as (x + 1, x).
+        */
+        uint64_t target = size / 2 + 1;
+        if (a.size() > target + 1 and a.size() < size) {
+            found = hgcd_top(a, b, max<uint64_t>(2 * target - a.size(), a.size() - size / 2), matrix) or found;
+        }
+    }
 
-            /*  The 0s in the beginning of the number that builtin types discard as useless information
-                are needed for concatenation with the beginning of the quotient, so they have to be added
-                back.
-            */
-            add_0s(quotient, i - quotient.length() - j);
+    return hgcd_lehmer(a, b, matrix) or found;
+}
 
-            result += quotient;
-            remainder %= 0x100000000ULL;
 
-            j = i;
+/**
+ * @brief   Euclid's algorithm on a >= b >= 0: a becomes their gcd and b becomes 0. matrix is multiplied by all the
+ *          quotients, on the rows it tracks.
+ * 
+ * @param a 
+ * @param b 
+ * @param matrix 
+ */
+static void limbs_gcd(scratch_vector& a, scratch_vector& b, gcd_matrix& matrix) {
+    scratch_vector new_a = gcd_value(1), new_b = gcd_value(1);
+    gcd_matrix new_matrix(matrix.first_row, matrix.second_row);
+
+    while (not gcd_is_zero(b)) {
+        uint64_t size = a.size();
+        lehmer_batch batch;
+
+        if (size >= GCD_HGCD_THRESHOLD and b.size() + 1 >= size) {
+            //  The top two thirds are reduced to one third, which cuts a third of the size of a and b.
+            scratch_vector high_a = gcd_high_part(a, size / 3), high_b = gcd_high_part(b, size / 3);
+            gcd_matrix top_matrix(true, true);
+            if (hgcd(high_a, high_b, top_matrix)) {
+                gcd_matrix_reduce(a, b, top_matrix, new_a, new_b);
+                gcd_matrix_multiply(matrix, top_matrix, new_matrix);
+            }
+            else {
+                gcd_division_step(a, b, matrix, new_a, new_b, new_matrix);
+            }
+        }
+        else if (lehmer_find(a, b, UINT64_MAX, batch) > 0) {
+            lehmer_reduce(a, b, batch, new_a, new_b);
+            lehmer_matrix_update(matrix, batch, new_matrix);
+        }
+        else {
+            gcd_division_step(a, b, matrix, new_a, new_b, new_matrix);
         }
+
+        a.swap(new_a);
+        b.swap(new_b);
+        matrix.swap(new_matrix);
     }
+}
 
-    truncate_0s(result);
 
-    return remainder;
+/**
+ * @brief Greatest common divisor of two single limbs, by the binary algorithm.
+ * 
+ * @param a 
+ * @param b 
+ * @return uint64_t 
+ */
+static uint64_t gcd_64(uint64_t a, uint64_t b) {
+    if (a == 0 or b == 0) {
+        return a | b;
+    }
+    unsigned shift = 0;
+    while (((a | b) & 1ULL) == 0) {
+        a >>= 1;
+        b >>= 1;
+        shift++;
+    }
+    while ((a & 1ULL) == 0) {
+        a >>= 1;
+    }
+    while (b != 0) {
+        while ((b & 1ULL) == 0) {
+            b >>= 1;
+        }
+        if (a > b) {
+            swap(a, b);
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+
+bigint gcd(const bigint& a, const bigint& b) {
+    bigint result;
+    if (a.values.size() == 1 and b.values.size() == 1) {
+        result.values[0] = gcd_64(a.values[0], b.values[0]);
+        return result;
+    }
+
+    bool a_larger = a.compare(b, false) * a.sign >= 0;
+    const bigint& large = a_larger ? a : b;
+    const bigint& small = a_larger ? b : a;
+    scratch_vector x(large.values.begin(), large.values.end(), bigint_memory_resource());
+    scratch_vector y(small.values.begin(), small.values.end(), bigint_memory_resource());
+    gcd_matrix matrix(false, false);
+    limbs_gcd(x, y, matrix);
+
+    result.values.assign(x.data(), x.data() + x.size());
+    return result;
+}
+
+bigint lcm(const bigint& a, const bigint& b) {
+    if (a == bigint(0) or b == bigint(0)) {
+        return bigint(0);
+    }
+    bigint result = a / gcd(a, b);
+    result *= b;
+    result.sign = 1;
+    return result;
+}
+
+bigint extended_gcd(const bigint& a, const bigint& b, bigint& x, bigint& y) {
+    bigint result;
+    if (b == bigint(0)) {
+        //  gcd(a, 0) = |a| = sign(a) * a.
+        result = a;
+        result.sign = 1;
+        x = a == bigint(0) ? bigint(0) : bigint(a.sign);
+        y = bigint(0);
+        return result;
+    }
+
+    //  Euclid's algorithm is run on |a| and |b|, largest first, keeping the cofactors of the largest.
+    bool a_larger = a.compare(b, false) * a.sign >= 0;
+    const bigint& large = a_larger ? a : b;
+    const bigint& small = a_larger ? b : a;
+    scratch_vector u(large.values.begin(), large.values.end(), bigint_memory_resource());
+    scratch_vector v(small.values.begin(), small.values.end(), bigint_memory_resource());
+    gcd_matrix matrix(false, true);
+    limbs_gcd(u, v, matrix);
+    result.values.assign(u.data(), u.data() + u.size());
+
+    //  gcd = m11 |large| - m01 |small|, or the opposite when the number of quotients is odd. m01 is not tracked.
+    bigint large_cofactor;
+    large_cofactor.values.assign(matrix.m11.data(), matrix.m11.data() + matrix.m11.size());
+    large_cofactor.sign = (int8_t) ((matrix.odd ? -1 : 1) * large.sign);
+    large_cofactor.remove_empty_values();
+
+    //  The other cofactor follows from large * large_cofactor + small * small_cofactor = gcd, unless small is 0.
+    bigint small_cofactor;
+    if (not (small.values.size() == 1 and small.values[0] == 0)) {
+        small_cofactor = (result - large * large_cofactor) / small;
+    }
+
+    x = a_larger ? std::move(large_cofactor) : std::move(small_cofactor);
+    y = a_larger ? std::move(small_cofactor) : std::move(large_cofactor);
+    return result;
+}
+
+bigint mod_inverse(const bigint& a, const bigint& modulus) {
+    if (modulus <= bigint(0)) {
+        throw domain_error("Modulus must be positive.");
+    }
+
+    bigint x, y;
+    bigint g = extended_gcd(a % modulus, modulus, x, y);
+    if (g != bigint(1)) {
+        throw domain_error("Value is not invertible modulo modulus.");
+    }
+
+    x %= modulus;
+    if (x < bigint(0)) {
+        x += modulus;
+    }
+    return x;
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------ROOTS----------------------------------------
+
+/*  Roots are computed by Newton's iteration, with a precision that doubles at each step: the root of the most
+    significant half of the digits is computed first (recursively), and gives a starting point that only needs
+    about one iteration at full size. The cost of a root is thus a small multiple of one division.
+*/
+
+/**
+ * @brief Residues modulo modulus that are squares, used to reject non-squares without computing a root.
+ * 
+ */
+struct square_filter {
+    uint64_t modulus;
+    vector<bool> is_square;
+};
+
+
+/**
+ * @brief Builds the square_filter of a modulus.
+ * 
+ * @param modulus 
+ * @return square_filter 
+ */
+static square_filter make_square_filter(const uint64_t& modulus) {
+    square_filter filter;
+    filter.modulus = modulus;
+    filter.is_square.assign(modulus, false);
+    for (uint64_t i = 0; i < modulus; i++) {
+        filter.is_square[i * i % modulus] = true;
+    }
+    return filter;
 }
 
 
 /**
- * @brief Divides the provided number by 2^64 and returns the remainder.
+ * @brief Applied to the least significant byte. Only 44 residues out of 256 are squares.
+ * 
+ */
+static const square_filter SQUARE_FILTER_256 = make_square_filter(256);
+
+/**
+ * @brief   Applied to the residue modulo 2^48 - 1 = 63 * 65 * 17 * 97 * 241 * 257 * 673. Together they let through
+ *          about one non-square in 400.
+ * 
+ */
+static const square_filter SQUARE_FILTERS_2_48[] = {
+    make_square_filter(63),
+    make_square_filter(65),
+    make_square_filter(17),
+    make_square_filter(97),
+    make_square_filter(241),
+    make_square_filter(257),
+    make_square_filter(673)
+};
+
+
+/**
+ * @brief   Returns a value congruent to a modulo 2^48 - 1, in [0, 2^48 - 1). As 2^48 = 1 modulo 2^48 - 1, this only
+ *          needs the sum of the 48 bits digits of a, without any division.
  * 
- * @param number A digit string representing the input number.
- * @param result A digit string representing the result. Will be overwritten by the function.
- * @return uint64_t remainder of the euclidean division.
+ * @param a 
+ * @param size 
+ * @return uint64_t 
  */
-static uint64_t string_euclid_64(const string& number, string& result) {
-    string quo32 = "";
-    uint64_t mod32 = string_euclid_32(number, quo32);
-    return 0x100000000ULL * string_euclid_32(quo32, result) + mod32;
+static uint64_t limbs_mod_2_48_minus_1(const uint64_t* a, const uint64_t& size) {
+    const uint64_t mask = (1ULL << 48) - 1;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < size; i++) {
+        //  Limb i weighs 2^(64 i) = 2^(16 (i mod 3)) modulo 2^48 - 1, and is split into two digits.
+        unsigned shift = 16 * (unsigned) (i % 3);
+        sum += ((a[i] << shift) & mask) + (a[i] >> (48 - shift));
+        sum = (sum & mask) + (sum >> 48);
+    }
+    sum = (sum & mask) + (sum >> 48);
+    return sum >= mask ? sum - mask : sum;
 }
 
+
 /**
- * @brief Retrieves a uint64_t from a string of digits. Returns 0 if pos is out of range.
+ * @brief Integer square root of a single limb.
  * 
- * @param number Source string.
- * @param pos Position of the number in the string.
- * @param len Number of digits to extract.
+ * @param n 
  * @return uint64_t 
  */
-static uint64_t string_to_64(const string& number, const uint64_t& pos, const uint64_t& len) {
-    if (len == 0) {
-        return 0;
+static uint64_t isqrt_64(const uint64_t& n) {
+    uint64_t root = (uint64_t) sqrt((double) n);
+    //  The floating point estimate is off by at most one. Comparisons by division cannot overflow.
+    while (root > 0 and root > n / root) {
+        root--;
     }
-    if (pos < number.length()) {
-        return stoull(number.substr(pos, len));
+    while (root + 1 <= n / (root + 1)) {
+        root++;
     }
-    return 0;
+    return root;
 }
 
 
 /**
- * @brief   Avoid using this when possible.
- *          Adjust given index and reach to fit inside given length.
- *          Used for exploring strings of digits from right to left by blocs.
+ * @brief Integer k-th root of n >= 0, for k >= 3.
  * 
- * @param i Index.
- * @param b Reach.
- * @param l Length.
+ * @param n 
+ * @param k 
+ * @return bigint 
  */
-static void adjust_index(uint64_t& i, uint64_t& b, const uint64_t& l) {
-    //  Change this from <= to < for a sort of subtle and long to fix bug.
-    if (i <= l) {
-            b = 2 * STEP_32;
-            i = l - i;
+static bigint iroot_magnitude(const bigint& n, const uint64_t& k) {
+    uint64_t bits = n.bit_length();
+    if (bits <= k) {
+        //  n < 2^k, so its root is 0 or 1.
+        return bits == 0 ? bigint(0) : bigint(1);
+    }
+
+    //  The root has at most root_bits bits. The root r of n / 2^(k m) gives (r + 1) 2^m > root(n), about m bits
+    //  too large.
+    uint64_t root_bits = (bits + k - 1) / k, m = root_bits / 2;
+    bigint root = iroot_magnitude(n >> (k * m), k) + bigint(1);
+    root <<= m;
+
+    //  From above, Newton's iteration decreases until it reaches the root.
+    bigint divisor((int64_t) k);
+    while (true) {
+        bigint next = root;
+        next.mul_small(k - 1);
+        next += n / pow(root, k - 1);
+        next /= divisor;
+        if (next >= root) {
+            return root;
         }
-        else if (i - l < 2 * STEP_32){
-            b = l % (2 * STEP_32);
-            i = 0;
+        root = std::move(next);
+    }
+}
+
+
+bigint isqrt(const bigint& n) {
+    if (n.sign < 0) {
+        throw domain_error("Square root of a negative value.");
+    }
+    if (n.values.size() == 1) {
+        return bigint((int64_t) isqrt_64(n.values[0]));
+    }
+
+    //  root approximates the square root of n / 4^(c - d) to within 1, d doubling at each step up to c, the bit
+    //  length of the root minus one. The quotient of each step only has d / 2 significant bits.
+    uint64_t c = (n.bit_length() - 1) / 2, d = 0;
+    bigint root = 1;
+    for (int s = 63 - (int) count_leading_zeros_64(c); s >= 0; s--) {
+        uint64_t e = d;
+        d = c >> s;
+        root = (root << (d - e - 1)) + (n >> (2 * c - e - d + 1)) / root;
+    }
+
+    //  The last step can overshoot by one.
+    if (root.square() > n) {
+        root -= bigint(1);
+    }
+    return root;
+}
+
+
+bigint iroot(const bigint& n, const uint64_t& k) {
+    if (k == 0) {
+        throw domain_error("Root of order 0.");
+    }
+    if (n.sign < 0 and k % 2 == 0) {
+        throw domain_error("Even root of a negative value.");
+    }
+    if (k == 1) {
+        return n;
+    }
+    if (k == 2) {
+        return isqrt(n);
+    }
+
+    bigint result = iroot_magnitude(n.sign < 0 ? -n : n, k);
+    result.sign = n.sign;
+    result.remove_empty_values();
+    return result;
+}
+
+
+bool is_perfect_square(const bigint& n) {
+    if (n.sign < 0) {
+        return false;
+    }
+
+    if (not SQUARE_FILTER_256.is_square[n.values[0] & 255]) {
+        return false;
+    }
+    uint64_t residue = limbs_mod_2_48_minus_1(n.values.data(), n.values.size());
+    for (const square_filter& filter : SQUARE_FILTERS_2_48) {
+        if (not filter.is_square[residue % filter.modulus]) {
+            return false;
         }
-        else {
-            b = 0, i = 0;
+    }
+
+    bigint root = isqrt(n);
+    return root.square() == n;
+}
+
+
+
+
+
+
+
+
+//  ----------------------------------------PRODUCT TREES----------------------------------------
+
+/*  Products of many values are computed as balanced trees: values are multiplied pairwise, then the products
+    pairwise, and so on. Operands of each product have about the same size, so the large ones go through the fast
+    multiplication tiers instead of multiplying a growing product by small values over and over. Products of a level
+    are independent and are spread across threads.
+*/
+
+/**
+ * @brief   Total size (in limbs) of a level of a product tree, or of the terms of a sum, below which it is computed
+ *          serially, as handing the work to other threads would cost more than it saves.
+ *          Can be tuned at runtime for a given machine.
+ * 
+ */
+static uint64_t PARALLEL_TREE_THRESHOLD = 256;
+
+
+/**
+ * @brief Returns the total number of limbs of the values in [first, last).
+ * 
+ * @param first 
+ * @param last 
+ * @return uint64_t 
+ */
+static uint64_t total_limbs(const bigint* first, const bigint* last) {
+    uint64_t total = 0;
+    for (const bigint* value = first; value != last; value++) {
+        total += (value->bit_length() + 63) / 64;
+    }
+    return total;
+}
+
+
+/**
+ * @brief   Calls multiply_pair(0) to multiply_pair(pairs - 1), which compute the products of a level of a product tree
+ *          of limbs limbs in total, serially or spread across threads.
+ * 
+ * @param pairs 
+ * @param limbs 
+ * @param multiply_pair 
+ */
+static void run_tree_level(const uint64_t& pairs, const uint64_t& limbs, const function<void(uint64_t)>& multiply_pair) {
+    if (limbs < PARALLEL_TREE_THRESHOLD) {
+        for (uint64_t i = 0; i < pairs; i++) {
+            multiply_pair(i);
+        }
+    }
+    else {
+        parallel_for(pairs, multiply_pair);
+    }
+}
+
+
+/**
+ * @brief   Multiplies the values in [first, last) pairwise until a single value is left, and returns it. 1 if there are
+ *          none. The first level reads the values in place, and only the products of later levels are moved from.
+ * 
+ * @param first 
+ * @param last 
+ * @return bigint 
+ */
+static bigint product_tree(const bigint* first, const bigint* last) {
+    uint64_t count = last - first;
+    if (count == 0) {
+        return bigint(1);
+    }
+    if (count == 1) {
+        return *first;
+    }
+
+    vector<bigint> level(count / 2 + count % 2);
+    run_tree_level(count / 2, total_limbs(first, last), [&](uint64_t i) {
+        level[i] = first[2 * i] * first[2 * i + 1];
+    });
+    if (count % 2 != 0) {
+        level.back() = first[count - 1];
+    }
+
+    while (level.size() > 1) {
+        uint64_t pairs = level.size() / 2;
+        vector<bigint> next(pairs + level.size() % 2);
+        run_tree_level(pairs, total_limbs(level.data(), level.data() + level.size()), [&](uint64_t i) {
+            next[i] = std::move(level[2 * i]) * level[2 * i + 1];
+        });
+
+        if (level.size() % 2 != 0) {
+            next.back() = std::move(level.back());
         }
+        level = std::move(next);
+    }
+    return std::move(level[0]);
 }
 
 
 /**
- * @brief   Adds together the numbers represented by two strings of digits.
- *          Does not work with negative numbers.
+ * @brief   Returns the products of the odd parts of first...last, packed so that each one fits in a limb, ready for
+ *          product_tree. Adds the number of factors 2 that were left out to twos.
  * 
- * @param number1 
- * @param number2 
- * @param result A string to store the result of the addition.
+ * @param first At least 1.
+ * @param last 
+ * @param twos 
+ * @return vector<bigint> 
  */
-static void string_add(const string& number1, const string& number2, string& result) {
-    result = "";
-    string temp;
+static vector<bigint> packed_odd_range(const uint64_t& first, const uint64_t& last, uint64_t& twos) {
+    vector<bigint> packs;
+    uint64_t pack = 1, high;
+
+    //  i != 0 stops the loop when last is UINT64_MAX.
+    for (uint64_t i = first; i <= last and i != 0; i++) {
+        uint64_t odd = i;
+        while ((odd & 1) == 0) {
+            odd >>= 1;
+            twos++;
+        }
+        uint64_t packed = mul_64_64(pack, odd, high);
+        if (high != 0) {
+            packs.push_back(bigint() + pack);
+            packed = odd;
+        }
+        pack = packed;
+    }
+    if (pack != 1) {
+        packs.push_back(bigint() + pack);
+    }
+    return packs;
+}
+
+
+bigint product(const vector<bigint>& factors) {
+    return product_tree(factors.data(), factors.data() + factors.size());
+}
+
+bigint sum(const vector<bigint>& terms) {
+    uint64_t count = terms.size();
+    uint64_t slices = total_limbs(terms.data(), terms.data() + count) < PARALLEL_TREE_THRESHOLD ? 1 : min(bigint_thread_count(), count);
+    if (slices <= 1) {
+        bigint result;
+        for (const bigint& term : terms) {
+            result += term;
+        }
+        return result;
+    }
+
+    vector<bigint> partial_sums(slices);
+    parallel_for(slices, [&](uint64_t slice) {
+        for (uint64_t i = slice * count / slices; i < (slice + 1) * count / slices; i++) {
+            partial_sums[slice] += terms[i];
+        }
+    });
+
+    bigint result;
+    for (const bigint& partial_sum : partial_sums) {
+        result += partial_sum;
+    }
+    return result;
+}
+
+bigint factorial(const uint64_t& n) {
+    uint64_t twos = 0;
+    vector<bigint> packs = packed_odd_range(1, n, twos);
+    bigint result = product_tree(packs.data(), packs.data() + packs.size());
+    result <<= twos;
+    return result;
+}
+
+bigint binomial(const uint64_t& n, const uint64_t& k) {
+    if (k > n) {
+        return bigint();
+    }
 
-    uint64_t l1 = number1.length(), l2 = number2.length();
-    uint64_t long_length = max(l1, l2);
-    uint64_t numbuffer = 0, carry = 0, i = 0, bias = 0, i1, i2, b1, b2;
+    //  n! / (k! (n - k)!) = ((n - k + 1)...n) / k!, with the smallest k.
+    uint64_t smallest = min(k, n - k);
+    uint64_t numerator_twos = 0, denominator_twos = 0;
+    vector<bigint> numerator_packs = packed_odd_range(n - smallest + 1, n, numerator_twos);
+    vector<bigint> denominator_packs = packed_odd_range(1, smallest, denominator_twos);
+    bigint numerator = product_tree(numerator_packs.data(), numerator_packs.data() + numerator_packs.size());
+    bigint denominator = product_tree(denominator_packs.data(), denominator_packs.data() + denominator_packs.size());
 
-    /*  Numbers are added together from right to left (of the string) by blocs of a little under 64 bits.
-        Bloc size could be closer to 64 bits for optimization but reusing STEP_32 in a simple way felt cleaner.
-    */
-    while (i < long_length or carry != 0) {
-        i += 2 * STEP_32;
+    bigint result = numerator / denominator;
+    result <<= numerator_twos - denominator_twos;
+    return result;
+}
 
-        i1 = i, i2 = i;
 
-        adjust_index(i1, b1, l1);
-        adjust_index(i2, b2, l2);
 
-        numbuffer = string_to_64(number1, i1, b1);
-        numbuffer += string_to_64(number2, i2, b2);
-        numbuffer += carry;
 
-        carry = numbuffer / pow_64(10, 2 * STEP_32);
-        numbuffer %= pow_64(10, 2 * STEP_32);
 
-        temp = to_string(numbuffer);
-        bias = temp.length();
 
-        add_0s(temp, 2 * STEP_32 - bias);
 
-        result = temp + result;
-    }
 
-    truncate_0s(result);
-}
+//  ----------------------------------------SERIALIZATION----------------------------------------
 
+/*  Binary format, version 1. All fields are little endian.
+    - bytes 0 to 3: "BGNT"
+    - bytes 4 and 5: format version
+    - byte 6: 1 for negative values, 0 otherwise
+    - byte 7: flags, SERIAL_FLAG_CHECKSUM if the checksum field is set
+    - bytes 8 to 15: number of limbs n, at least 1
+    - bytes 16 to 23: checksum of the sign, n and the limbs, or 0
+    - bytes 24 to 24 + 8 n: limbs, least significant first
+    The header keeps the limbs 8 bytes aligned, so that they can be used in place from an aligned mapping.
+*/
+
+static const unsigned char SERIAL_MAGIC[4] = {'B', 'G', 'N', 'T'};
+static const uint16_t SERIAL_VERSION = 1;
+static const uint64_t SERIAL_HEADER_SIZE = 24;
+static const unsigned char SERIAL_FLAG_CHECKSUM = 1;
 
 /**
- * @brief Multiplies the number represented by a string of digits by 2^32.
+ * @brief   Number of limbs read from a stream at a time. The header's limb count is not trusted before the limbs have
+ *          arrived: a corrupted count costs at most one chunk of memory before the truncation is detected.
  * 
- * @param number Number to be multiplied.
- * @param result String to store the result.
  */
-static void string_mult_32(const string& number, string& result) {
-    result = "";
-    uint64_t len = number.length();
-
-    uint64_t buffer_int;
-    string buffer_string, buffer_result;
+static const uint64_t SERIAL_STREAM_CHUNK = 1 << 16;
 
-    /*  Multiplication is performed by blocs of just under 32 bits so that
-        the result still fits inside a uint64_t. Could have been plain 32 bits for better performance. 
-    */
-    for (uint64_t i = 0; i < len; i += STEP_32) {
-        buffer_int = string_to_64(number, i, STEP_32);
-        buffer_int *= 0x100000000ULL;
-
-        buffer_string = "";
 
-        uint64_t number_of_0s = len - i - STEP_32;
+/**
+ * @brief Reads a little endian 64 bits value from unaligned bytes.
+ * 
+ * @param bytes 
+ * @return uint64_t 
+ */
+static uint64_t load_le_64(const unsigned char* bytes) {
+    uint64_t value;
+    memcpy(&value, bytes, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
 
-        //  Overflow management. May or may not cause bugs for numbers more than 2^64 - 8 digits long.
-        if (number_of_0s > len) {
-            number_of_0s = 0;
-        }
 
-        add_0s(buffer_string, number_of_0s);
+/**
+ * @brief Writes a 64 bits value to unaligned bytes, in little endian order.
+ * 
+ * @param bytes 
+ * @param value 
+ */
+static void store_le_64(unsigned char* bytes, uint64_t value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    memcpy(bytes, &value, 8);
+}
 
-        buffer_string = to_string(buffer_int) + buffer_string;
-        string_add(buffer_string, result, buffer_result);
 
-        result = buffer_result;
-    }
-} 
+/**
+ * @brief Returns whether limbs are stored in memory in the same order as in the format, so they can be copied as is.
+ * 
+ * @return bool 
+ */
+static bool serial_native_order() {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return false;
+#else
+    return true;
+#endif
+}
 
 
 /**
- * @brief   Multiplies the number represented by a string of digits by 2^64.
- *          Using blocs of 32 is necessary since 64 blocs would overflow.
+ * @brief   Fletcher's checksum on 64 bits words: two sums modulo 2^64 - 1, the second one of the successive values of the
+ *          first, so that swapped limbs are detected too. Starts from the sign and the number of limbs.
  * 
- * @param number Number to be multiplied.
- * @param result String to store the result.
+ * @param limb_bytes Little endian limbs.
+ * @param size Number of limbs.
+ * @param sign 
+ * @return uint64_t 
  */
-static void string_mult_64(const string& number, string& result) {
-    string buffer_string;
-    string_mult_32(number, buffer_string);
-    string_mult_32(buffer_string, result);
+static uint64_t serial_checksum(const unsigned char* limb_bytes, const uint64_t& size, const int8_t& sign) {
+    uint64_t first = sign < 0 ? 2 : 1, second = size;
+    for (uint64_t i = 0; i < size; i++) {
+        uint64_t limb = load_le_64(limb_bytes + 8 * i), sum = first + limb;
+        //  End around carry.
+        first = sum + (sum < limb);
+        sum = second + first;
+        second = sum + (sum < first);
+    }
+    return first ^ (second << 32 | second >> 32);
 }
 
 
 /**
- * @brief Checks wether a character is a digit or not.
+ * @brief Fields of a serialized bigint's header.
  * 
- * @param c character to test
  */
-static bool isdigit(const char& c) {
-    int ascii_code = (int) c;
-    return ascii_code < 58 and ascii_code > 47;
-}
+struct serial_header {
+    int8_t sign;
+    bool checksummed;
+    uint64_t checksum;
+    uint64_t limb_count;
+};
 
 
 /**
- * @brief   Compare function for uint64_t since I couldn't find the original one.
- *          Returns -1 if v1 is smaller, 0 if equal, 1 else.
+ * @brief   Reads and checks a header. Throws an invalid_argument if it is not valid, or if its limbs do not fit in
+ *          available bytes (the header included).
  * 
- * @param v1 
- * @param v2 
- * @return int 
+ * @param data SERIAL_HEADER_SIZE bytes.
+ * @param available 
+ * @return serial_header 
  */
-static int compare_64(const uint64_t& v1, const uint64_t& v2) {
-    if (v1 < v2) {
-        return -1;
+static serial_header read_serial_header(const unsigned char* data, const uint64_t& available) {
+    if (available < SERIAL_HEADER_SIZE) {
+        throw invalid_argument("Serialized bigint is truncated.");
     }
-    if (v1 > v2) {
-        return 1;
+    if (memcmp(data, SERIAL_MAGIC, 4) != 0) {
+        throw invalid_argument("Data is not a serialized bigint.");
     }
-    return 0;
+    if ((uint16_t) (data[4] | data[5] << 8) != SERIAL_VERSION) {
+        throw invalid_argument("Unsupported bigint serialization version.");
+    }
+    if (data[6] > 1 or (data[7] & ~SERIAL_FLAG_CHECKSUM) != 0) {
+        throw invalid_argument("Invalid serialized bigint header.");
+    }
+
+    serial_header header;
+    header.sign = data[6] ? -1 : 1;
+    header.checksummed = data[7] & SERIAL_FLAG_CHECKSUM;
+    header.checksum = load_le_64(data + 16);
+    header.limb_count = load_le_64(data + 8);
+    if (header.limb_count == 0) {
+        throw invalid_argument("Invalid serialized bigint header.");
+    }
+    if (header.limb_count > (available - SERIAL_HEADER_SIZE) / 8) {
+        throw invalid_argument("Serialized bigint is truncated.");
+    }
+    return header;
 }
 
 
 /**
- * @brief Applies one's complement to given number.
+ * @brief Writes a header.
  * 
- * @param number 
+ * @param out SERIAL_HEADER_SIZE bytes.
+ * @param sign 
+ * @param limb_count 
+ * @param with_checksum 
+ * @param checksum 
  */
-static void ones_complement(uint64_t& number) {
-    number = number xor UINT64_MAX;
+static void write_serial_header(unsigned char* out, const int8_t& sign, const uint64_t& limb_count,
+                                const bool& with_checksum, const uint64_t& checksum) {
+    memcpy(out, SERIAL_MAGIC, 4);
+    out[4] = (unsigned char) (SERIAL_VERSION & 0xFF);
+    out[5] = (unsigned char) (SERIAL_VERSION >> 8);
+    out[6] = sign < 0 ? 1 : 0;
+    out[7] = with_checksum ? SERIAL_FLAG_CHECKSUM : 0;
+    store_le_64(out + 8, limb_count);
+    store_le_64(out + 16, with_checksum ? checksum : 0);
 }
 
 
 /**
- * @brief   Modifies given value to store either of its 2 32 blocs content depending on index parity.
- *          If index is even, the fisrt bloc is selected. Else, the second.
+ * @brief Copies little endian limbs to memory.
  * 
- * @param value 
- * @param index 
+ * @param result 
+ * @param limb_bytes 
+ * @param size 
  */
-static void select_32_in_64(uint64_t& value, const uint64_t& index) {
-    if (index % 2 == 0) {
-        value %= 0x100000000ULL;
+static void serial_load_limbs(uint64_t* result, const unsigned char* limb_bytes, const uint64_t& size) {
+    if (serial_native_order()) {
+        memcpy(result, limb_bytes, 8 * size);
+        return;
     }
-    else {
-        value /= 0x100000000ULL;
+    for (uint64_t i = 0; i < size; i++) {
+        result[i] = load_le_64(limb_bytes + 8 * i);
     }
 }
 
 
+bigint_view::bigint_view(const void* data, const uint64_t& size) {
+    const unsigned char* bytes = (const unsigned char*) data;
+    serial_header header = read_serial_header(bytes, size);
+    limb_bytes = bytes + SERIAL_HEADER_SIZE;
+    limb_count = header.limb_count;
+    value_sign = header.sign;
+    checksummed = header.checksummed;
+    checksum = header.checksum;
+}
 
+uint64_t bigint_view::size() const {
+    return limb_count;
+}
 
+int8_t bigint_view::sign() const {
+    return value_sign;
+}
 
+uint64_t bigint_view::limb(const uint64_t& index) const {
+    return load_le_64(limb_bytes + 8 * index);
+}
 
+const uint64_t* bigint_view::limbs() const {
+    if (not serial_native_order() or (uintptr_t) limb_bytes % alignof(uint64_t) != 0) {
+        return nullptr;
+    }
+    return (const uint64_t*) limb_bytes;
+}
 
+uint64_t bigint_view::byte_size() const {
+    return SERIAL_HEADER_SIZE + 8 * limb_count;
+}
 
-//  ----------------------------------------PRIVATE METHODS AND PROCEDURES----------------------------------------
-
-void bigint::set_values_to_zero() {
-    for(uint64_t& val : values) {
-        val = 0ULL;
-    }
+bool bigint_view::has_checksum() const {
+    return checksummed;
 }
 
+bool bigint_view::verify() const {
+    return not checksummed or serial_checksum(limb_bytes, limb_count, value_sign) == checksum;
+}
 
-void bigint::remove_empty_values() {
-    uint64_t values_size = values.size();
-    for (uint64_t i = 0; i < values_size - 1; i++) {
-        if (values[values_size - i - 1] == 0) {
-            values.pop_back();
-        }
-    }
+bigint bigint_view::to_bigint() const {
+    bigint result;
+    result.values.resize(limb_count);
+    serial_load_limbs(result.values.data(), limb_bytes, limb_count);
+    result.sign = value_sign;
+    result.remove_empty_values();
+    return result;
 }
 
 
-void bigint::assign_string(const string& number) {
-    string value_buffer = number;
-    string result_buffer = "";
+uint64_t serialized_size(const bigint& value) {
+    return SERIAL_HEADER_SIZE + 8 * value.values.size();
+}
 
-    if (value_buffer.length() > 0 and value_buffer[0] == '-') {
-        sign = -1;
-        value_buffer.erase(0, 1);
+void serialize(const bigint& value, unsigned char* out, const bool& with_checksum) {
+    uint64_t size = value.values.size();
+    unsigned char* limb_bytes = out + SERIAL_HEADER_SIZE;
+    if (serial_native_order()) {
+        memcpy(limb_bytes, value.values.data(), 8 * size);
     }
     else {
-        sign = 1;
-    }
-
-    //  Checking for incorrect characters in the string.
-    for (char c: value_buffer) {
-        if (!isdigit(c)) {
-            throw invalid_argument("Number string should contain digits only.");
+        for (uint64_t i = 0; i < size; i++) {
+            store_le_64(limb_bytes + 8 * i, value.values[i]);
         }
     }
 
-    //  Resetting the values vector prior to filling it again.
-    values.clear();
-
-    // Decomposing the number string in base 2^64.
-    while (value_buffer != "") {
-        values.push_back(string_euclid_64(value_buffer, result_buffer));
-        value_buffer = result_buffer;
-    }
+    uint64_t checksum = with_checksum ? serial_checksum(limb_bytes, size, value.sign) : 0;
+    write_serial_header(out, value.sign, size, with_checksum, checksum);
 }
 
+void serialize(const bigint& value, ostream& os, const bool& with_checksum) {
+    uint64_t size = value.values.size();
+    if (not serial_native_order()) {
+        //  The limbs need to be reordered anyway, so they go through a buffer.
+        vector<unsigned char> buffer(serialized_size(value));
+        serialize(value, buffer.data(), with_checksum);
+        os.write((const char*) buffer.data(), (streamsize) buffer.size());
+        return;
+    }
 
-void bigint::assign_add(const bigint& second_int, const int8_t& add_sign) {
-    /*  My apologies for this ugly function, I had no time to clean it.
-        It is stable and rather efficient but clearly violates encapsulation principle.
-        Also, sorry for the poor variable name choices and over-the-top casts.
-    */
-
-    uint64_t carry = 0, numbuffer;
-    uint64_t l1 = values.size(), l2 = second_int.values.size();
-    uint64_t long_length = max(l1, l2);
+    unsigned char header[SERIAL_HEADER_SIZE];
+    const unsigned char* limb_bytes = (const unsigned char*) value.values.data();
+    uint64_t checksum = with_checksum ? serial_checksum(limb_bytes, size, value.sign) : 0;
+    write_serial_header(header, value.sign, size, with_checksum, checksum);
+    os.write((const char*) header, (streamsize) SERIAL_HEADER_SIZE);
+    os.write((const char*) limb_bytes, (streamsize) (8 * size));
+}
 
-    //  int8_t casts are here to prevent warnings.
-    //  Compute wether the actual operation is a sum or substraction.
-    int8_t effective_sign = (int8_t) ((int8_t) (sign * add_sign) * second_int.sign);
-    int8_t result_sign;
+bigint deserialize(const unsigned char* data, const uint64_t& size) {
+    bigint_view view(data, size);
+    if (not view.verify()) {
+        throw invalid_argument("Serialized bigint does not match its checksum.");
+    }
+    return view.to_bigint();
+}
 
-    //  Compute result's sign as this implementation of one's complenent does not do it to allow the number's memory size to grow.
-    if (effective_sign < 0) {
-        result_sign = compare(second_int, false);
-        if (result_sign == 0) {
-            result_sign = 1;
+bigint deserialize(istream& is) {
+    unsigned char header_bytes[SERIAL_HEADER_SIZE];
+    if (not is.read((char*) header_bytes, (streamsize) SERIAL_HEADER_SIZE)) {
+        throw invalid_argument("Serialized bigint is truncated.");
+    }
+    //  The number of limbs is only known to fit once they are read, so the result grows as they arrive.
+    serial_header header = read_serial_header(header_bytes, UINT64_MAX);
+
+    bigint result;
+    result.values.clear();
+    for (uint64_t read = 0; read < header.limb_count; read += SERIAL_STREAM_CHUNK) {
+        uint64_t chunk = min(SERIAL_STREAM_CHUNK, header.limb_count - read);
+        result.values.resize(read + chunk);
+        if (not is.read((char*) (result.values.data() + read), (streamsize) (8 * chunk))) {
+            throw invalid_argument("Serialized bigint is truncated.");
         }
     }
-    else {
-        result_sign = sign;
+    unsigned char* limb_bytes = (unsigned char*) result.values.data();
+    if (header.checksummed and serial_checksum(limb_bytes, header.limb_count, header.sign) != header.checksum) {
+        throw invalid_argument("Serialized bigint does not match its checksum.");
     }
+    if (not serial_native_order()) {
+        for (uint64_t i = 0; i < header.limb_count; i++) {
+            result.values[i] = load_le_64(limb_bytes + 8 * i);
+        }
+    }
+    result.sign = header.sign;
+    result.remove_empty_values();
+    return result;
+}
 
-    sign = result_sign;
 
-    for (uint64_t i = 0; i < long_length or carry != 0; i++) {
 
-        //  If end of vector reached, add space.
-        if (i >= l1) {
-            values.push_back(0ULL);
-        }
 
-        numbuffer = values[i];
 
-        if (effective_sign < 0) {
-            ones_complement(numbuffer);
-        }
 
-        // Add carry, check for overflow
-        numbuffer = add_check_overflow(numbuffer, carry, carry);
 
-        //  If end of second bigint vector not reached yet add its value.
-        if (i < l2) {
 
-            //  Only check for overlfow if no overflow occured yet. Math says two overflows is impossible.
-            if (carry != 0) {
-                numbuffer += second_int.values[i];
-            }
-            else {
-                numbuffer = add_check_overflow(numbuffer, second_int.values[i], carry);
-            }
-        }
+//  ----------------------------------------FIXED WIDTH----------------------------------------
 
-        //  Update vector value.
-        values[i] = numbuffer;
+/*  fixed_bigint loops are unrolled by expanding index sequences: a fold over the comma operator evaluates its
+    operands from left to right, so carries and borrows still propagate from the least significant limb up.
+    The limb helpers below are constexpr versions of the kernels bigint uses.
+*/
 
-        if (i + 1 == long_length and effective_sign < 0) {
-            break;
-        }
-    }
+/**
+ * @brief Returns a + b + carry and sets carry to the carry out. constexpr.
+ * 
+ * @param a 
+ * @param b 
+ * @param carry 0 or 1.
+ * @return uint64_t 
+ */
+constexpr uint64_t fixed_add_64(const uint64_t& a, const uint64_t& b, uint64_t& carry) {
+    uint64_t sum = a + b;
+    uint64_t carry_a = sum < a;
+    uint64_t result = sum + carry;
+    carry = carry_a | (result < sum);
+    return result;
+}
 
-    //  One's complement shenanigans. If there is a carry, add it to the result. Else, get one's complement of the result.
-    if (effective_sign < 0) {
-        if (carry == 0) {
-            for (uint64_t i = 0; i < long_length; i++) {
-                ones_complement(values[i]);
-            }
-        }
-        else {
-            for (uint64_t i = 0; i < long_length and carry != 0; i++) {
-                numbuffer = values[i];
-                numbuffer = add_check_overflow(numbuffer, carry, carry);
-                values[i] = numbuffer;
-            }
-        }
 
-        /*  Clean possible free space at the front of the result.
-            Do it only for effective_sign < 0 or it might break multiplication
-            (multiplication makes use of this free space to avoid checking for vector lengths all the time but only uses additions).
-            If the absolute value of the number grows it is useless to do it anyways.
-            Might be a problem for a future implementation of division.
-        */
-        remove_empty_values();
-    }
+/**
+ * @brief Returns a - b - borrow and sets borrow to the borrow out. constexpr.
+ * 
+ * @param a 
+ * @param b 
+ * @param borrow 0 or 1.
+ * @return uint64_t 
+ */
+constexpr uint64_t fixed_sub_64(const uint64_t& a, const uint64_t& b, uint64_t& borrow) {
+    uint64_t difference = a - b;
+    uint64_t borrow_a = difference > a;
+    uint64_t result = difference - borrow;
+    borrow = borrow_a | (result > difference);
+    return result;
+}
+
+
+/**
+ * @brief   Returns the low limb of a * b + addend + carry and sets carry to its high limb, which cannot overflow.
+ *          constexpr, with the same 32 bits blocs fallback as mul_64_64 when 128 bits integers are not available.
+ * 
+ * @param a 
+ * @param b 
+ * @param addend 
+ * @param carry 
+ * @return uint64_t 
+ */
+constexpr uint64_t fixed_muladd_64(const uint64_t& a, const uint64_t& b, const uint64_t& addend, uint64_t& carry) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 full = (unsigned __int128) a * b + addend + carry;
+    carry = (uint64_t) (full >> 64);
+    return (uint64_t) full;
+#else
+    uint64_t a_low = a & 0xFFFFFFFFULL, a_high = a >> 32;
+    uint64_t b_low = b & 0xFFFFFFFFULL, b_high = b >> 32;
+    uint64_t low_low = a_low * b_low, low_high = a_low * b_high;
+    uint64_t high_low = a_high * b_low, high_high = a_high * b_high;
+    uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFFULL) + (high_low & 0xFFFFFFFFULL);
+    uint64_t low = (middle << 32) | (low_low & 0xFFFFFFFFULL);
+    uint64_t high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+    uint64_t sum_carry = 0;
+    low = fixed_add_64(low, addend, sum_carry);
+    high += sum_carry;
+    sum_carry = 0;
+    low = fixed_add_64(low, carry, sum_carry);
+    carry = high + sum_carry;
+    return low;
+#endif
 }
 
 
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits>::fixed_bigint() : values() {}
 
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits>::fixed_bigint(const uint64_t& initial_value) : values() {
+    values[0] = initial_value;
+}
 
+template<uint64_t Bits>
+fixed_bigint<Bits>::fixed_bigint(const bigint& initial_value) : values() {
+    uint64_t size = initial_value.values.size();
+    if (initial_value.sign < 0 or size > LIMBS) {
+        throw out_of_range("Value does not fit in a fixed_bigint.");
+    }
+    copy(initial_value.values.begin(), initial_value.values.end(), values);
+}
 
+template<uint64_t Bits>
+fixed_bigint<Bits> fixed_bigint<Bits>::truncate(const bigint& value) {
+    fixed_bigint result;
+    uint64_t size = min<uint64_t>(value.values.size(), LIMBS);
+    copy(value.values.begin(), value.values.begin() + size, result.values);
+    //  -x mod 2^Bits = 0 - (x mod 2^Bits).
+    return value.sign < 0 ? fixed_bigint() - result : result;
+}
 
+template<uint64_t Bits>
+bigint fixed_bigint<Bits>::to_bigint() const {
+    bigint result;
+    result.values.assign(values, values + LIMBS);
+    result.remove_empty_values();
+    return result;
+}
 
+template<uint64_t Bits>
+string fixed_bigint<Bits>::to_string(const uint64_t& base) const {
+    return to_bigint().to_string(base);
+}
 
-//  ----------------------------------------PUBLIC METHODS AND PROCEDURES----------------------------------------
+template<uint64_t Bits>
+constexpr uint64_t fixed_bigint<Bits>::limb(const uint64_t& index) const {
+    return values[index];
+}
 
-//  CONSTRUCTORS
+template<uint64_t Bits>
+template<size_t... I>
+constexpr uint64_t fixed_bigint<Bits>::add_limbs(fixed_bigint& result, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>) {
+    uint64_t carry = 0;
+    ((result.values[I] = fixed_add_64(a.values[I], b.values[I], carry)), ...);
+    return carry;
+}
 
-bigint::bigint() : values({0}), sign(true) {}
+template<uint64_t Bits>
+template<size_t... I>
+constexpr uint64_t fixed_bigint<Bits>::sub_limbs(fixed_bigint& result, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>) {
+    uint64_t borrow = 0;
+    ((result.values[I] = fixed_sub_64(a.values[I], b.values[I], borrow)), ...);
+    return borrow;
+}
 
-bigint::bigint(const int64_t& initial_value) {
-    sign = initial_value >= 0 ? 1 : -1;
-    uint64_t n_val = (uint64_t) (initial_value * (int64_t) sign);
-    values.push_back(n_val);
+template<uint64_t Bits>
+template<size_t Row, bool Truncated, size_t... J>
+constexpr void fixed_bigint<Bits>::mul_row(uint64_t* product, const fixed_bigint& a, const uint64_t& b_limb, index_sequence<J...>) {
+    uint64_t carry = 0;
+    ((product[Row + J] = fixed_muladd_64(a.values[J], b_limb, product[Row + J], carry)), ...);
+    if constexpr (!Truncated) {
+        product[Row + LIMBS] = carry;
+    }
 }
 
-bigint::bigint(const string& number_string) {
-    assign_string(number_string);
+template<uint64_t Bits>
+template<size_t... I>
+constexpr void fixed_bigint<Bits>::mul_limbs(fixed_bigint& result, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>) {
+    //  Row I only has LIMBS - I limbs below 2^Bits.
+    (mul_row<I, true>(result.values, a, b.values[I], make_index_sequence<LIMBS - I>()), ...);
 }
 
-bigint::bigint(const bigint& source_int) : values(source_int.values), sign(source_int.sign) {}
+template<uint64_t Bits>
+template<size_t... I>
+constexpr void fixed_bigint<Bits>::mul_limbs_full(uint64_t* product, const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>) {
+    (mul_row<I, false>(product, a, b.values[I], make_index_sequence<LIMBS>()), ...);
+}
 
+template<uint64_t Bits>
+template<typename Operation, size_t... I>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::bitwise(const fixed_bigint& a, const fixed_bigint& b, const Operation& operation, index_sequence<I...>) {
+    fixed_bigint result;
+    ((result.values[I] = operation(a.values[I], b.values[I])), ...);
+    return result;
+}
 
+template<uint64_t Bits>
+template<size_t... I>
+constexpr int8_t fixed_bigint<Bits>::compare_limbs(const fixed_bigint& a, const fixed_bigint& b, index_sequence<I...>) {
+    //  The first difference found from the most significant limb decides.
+    int8_t comparison = 0;
+    ((comparison = comparison != 0 ? comparison : (int8_t) (a.values[LIMBS - 1 - I] > b.values[LIMBS - 1 - I]) -
+                                                  (int8_t) (a.values[LIMBS - 1 - I] < b.values[LIMBS - 1 - I])), ...);
+    return comparison;
+}
 
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator+(const fixed_bigint& second_int) const {
+    fixed_bigint result;
+    add_limbs(result, *this, second_int, make_index_sequence<LIMBS>());
+    return result;
+}
 
-//  HELPER METHODS AND PROCEDURES
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator-(const fixed_bigint& second_int) const {
+    fixed_bigint result;
+    sub_limbs(result, *this, second_int, make_index_sequence<LIMBS>());
+    return result;
+}
 
-string bigint::to_string() const{
-    string value_string = "";
-    string buffer_result;
-    uint64_t val_size = values.size();
-    for (uint64_t i = 0; i < values.size(); i++) {
-        string_mult_64(value_string, buffer_result);
-        value_string = buffer_result;
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator*(const fixed_bigint& second_int) const {
+    fixed_bigint result;
+    mul_limbs(result, *this, second_int, make_index_sequence<LIMBS>());
+    return result;
+}
 
-        string_add(value_string, std::to_string(values[val_size - i - 1]), buffer_result);
-        value_string = buffer_result;
-    }
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits>& fixed_bigint<Bits>::operator+=(const fixed_bigint& second_int) {
+    add_limbs(*this, *this, second_int, make_index_sequence<LIMBS>());
+    return *this;
+}
 
-    if (sign < 0) {
-        value_string = "-" + value_string;
-    }
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits>& fixed_bigint<Bits>::operator-=(const fixed_bigint& second_int) {
+    sub_limbs(*this, *this, second_int, make_index_sequence<LIMBS>());
+    return *this;
+}
 
-    if (value_string == "") {
-        value_string = "0";
-    }
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits>& fixed_bigint<Bits>::operator*=(const fixed_bigint& second_int) {
+    //  Rows read limbs of both operands that earlier rows would have overwritten.
+    *this = *this * second_int;
+    return *this;
+}
 
-    return value_string;
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator&(const fixed_bigint& second_int) const {
+    return bitwise(*this, second_int, [](const uint64_t& a, const uint64_t& b) { return a & b; }, make_index_sequence<LIMBS>());
 }
 
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator|(const fixed_bigint& second_int) const {
+    return bitwise(*this, second_int, [](const uint64_t& a, const uint64_t& b) { return a | b; }, make_index_sequence<LIMBS>());
+}
 
-int8_t bigint::compare(const bigint& second_int, bool signed_comparisson) const {
-    if (sign != second_int.sign and signed_comparisson) {
-        return sign;
-    }
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator^(const fixed_bigint& second_int) const {
+    return bitwise(*this, second_int, [](const uint64_t& a, const uint64_t& b) { return a ^ b; }, make_index_sequence<LIMBS>());
+}
 
-    uint64_t values_size = values.size();
-    uint64_t second_size = second_int.values.size();
-    if (values_size != second_size) {
-        return (int8_t) (sign * (int8_t) (values_size > second_size ? 1 : -1));
-    }
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator~() const {
+    return bitwise(*this, *this, [](const uint64_t& a, const uint64_t&) { return ~a; }, make_index_sequence<LIMBS>());
+}
 
-    int comparisson = 0;
-    for (uint64_t i = 0; i < values_size; i++) {
-        comparisson += compare_64(values[values_size - i - 1], second_int.values[values_size - i - 1]);
-        if (comparisson != 0) {
-            return (int8_t) (comparisson * sign);
-        }
-    }
-    return 0;
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::overflowing_add(const fixed_bigint& second_int, bool& overflow) const {
+    fixed_bigint result;
+    overflow = add_limbs(result, *this, second_int, make_index_sequence<LIMBS>()) != 0;
+    return result;
 }
 
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::overflowing_sub(const fixed_bigint& second_int, bool& overflow) const {
+    fixed_bigint result;
+    overflow = sub_limbs(result, *this, second_int, make_index_sequence<LIMBS>()) != 0;
+    return result;
+}
 
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::overflowing_mul(const fixed_bigint& second_int, bool& overflow) const {
+    uint64_t product[2 * LIMBS] = {};
+    mul_limbs_full(product, *this, second_int, make_index_sequence<LIMBS>());
 
+    fixed_bigint result;
+    overflow = false;
+    for (uint64_t i = 0; i < LIMBS; i++) {
+        result.values[i] = product[i];
+        overflow = overflow or product[LIMBS + i] != 0;
+    }
+    return result;
+}
 
-//  OPERATOR OVERLOADS
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::checked_add(const fixed_bigint& second_int) const {
+    bool overflow = false;
+    fixed_bigint result = overflowing_add(second_int, overflow);
+    if (overflow) {
+        throw overflow_error("fixed_bigint addition overflow.");
+    }
+    return result;
+}
 
-ostream& operator<<(ostream& os, const bigint& number) {
-    os << number.to_string();
-    return os;
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::checked_sub(const fixed_bigint& second_int) const {
+    bool overflow = false;
+    fixed_bigint result = overflowing_sub(second_int, overflow);
+    if (overflow) {
+        throw overflow_error("fixed_bigint subtraction overflow.");
+    }
+    return result;
 }
 
-void bigint::operator=(const bigint& r_value) {
-    values = r_value.values;
-    sign = r_value.sign;
+template<uint64_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::checked_mul(const fixed_bigint& second_int) const {
+    bool overflow = false;
+    fixed_bigint result = overflowing_mul(second_int, overflow);
+    if (overflow) {
+        throw overflow_error("fixed_bigint product overflow.");
+    }
+    return result;
 }
 
-void bigint::operator=(const string& r_value) {
-    assign_string(r_value);
+template<uint64_t Bits>
+constexpr int8_t fixed_bigint<Bits>::compare(const fixed_bigint& second_int) const {
+    return compare_limbs(*this, second_int, make_index_sequence<LIMBS>());
 }
 
-bool bigint::operator<(const bigint& second_int) const {
+template<uint64_t Bits>
+constexpr bool fixed_bigint<Bits>::operator<(const fixed_bigint& second_int) const {
     return compare(second_int) < 0;
 }
 
-bool bigint::operator>(const bigint& second_int) const {
+template<uint64_t Bits>
+constexpr bool fixed_bigint<Bits>::operator>(const fixed_bigint& second_int) const {
     return compare(second_int) > 0;
 }
 
-bool bigint::operator==(const bigint& second_int) const {
+template<uint64_t Bits>
+constexpr bool fixed_bigint<Bits>::operator==(const fixed_bigint& second_int) const {
     return compare(second_int) == 0;
 }
 
-bool bigint::operator<=(const bigint& second_int) const {
+template<uint64_t Bits>
+constexpr bool fixed_bigint<Bits>::operator<=(const fixed_bigint& second_int) const {
     return compare(second_int) <= 0;
 }
 
-bool bigint::operator>=(const bigint& second_int) const {
+template<uint64_t Bits>
+constexpr bool fixed_bigint<Bits>::operator>=(const fixed_bigint& second_int) const {
     return compare(second_int) >= 0;
 }
 
-bool bigint::operator!=(const bigint& second_int) const {
+template<uint64_t Bits>
+constexpr bool fixed_bigint<Bits>::operator!=(const fixed_bigint& second_int) const {
     return compare(second_int) != 0;
 }
 
-void bigint::operator+=(const bigint& second_int) {
-    assign_add(second_int, 1);
-}
-
-void bigint::operator-=(const bigint& second_int) {
-    assign_add(second_int, -1);
-}
-
-void bigint::operator*=(const bigint& second_int) {
-    /*  This is implemented using operator* and not the other way around
-        because I couldn't find a clean implementation for en-place/on-the-spot products.
-        Copying the caller's values vector during the product would cost almost as much as
-        creating a new bigint so I didnt do that.
-    */
-    *this = *this * second_int;
-}
-
-bigint bigint::operator-() {
-    bigint new_bigint(*this);
-    new_bigint.sign *= -1;
-    return new_bigint;
+template<uint64_t Bits>
+ostream& operator<<(ostream& os, const fixed_bigint<Bits>& number) {
+    os << number.to_bigint();
+    return os;
 }
 
-bigint bigint::operator*(const bigint& second_int) const {
-    /*  Multiplies the operands by blocs of 32 bits. Because the result of a singlular
-        32 bits product takes up 64 bits, this implementation uses two buffers offset
-        by 32bits from each other so that singular results never overlap
-        (and therefore have to be added together by hand).
-        It's not much but I was a kinda proud of this.
-    */
-    bigint intermediate_buffer_0, intermediate_buffer_32, result_buffer;
 
-    uint64_t l1 = values.size(), l2 = second_int.values.size();
 
-    uint64_t operation_buffer, operand_buffer;
 
-    //  Making enough room to store everything in the buffer bigints.
-    for (uint64_t i = 1; i < l1 + l2; i++) {
-        intermediate_buffer_0.values.push_back(0ULL);
-        intermediate_buffer_32.values.push_back(0ULL);
-        result_buffer.values.push_back(0ULL);
-    }
 
-    //  Iterating on 32 bits blocs on the caller.
-    for (uint64_t i = 0; i < 2 * l1; i++) {
-        intermediate_buffer_0.set_values_to_zero();
-        intermediate_buffer_32.set_values_to_zero();
 
-        operand_buffer = values[i / 2];
-        select_32_in_64(operand_buffer, i);
 
-        //  32 bits blocs ftw ! Iterating on second_int.
-        for (uint64_t j = 0; j < 2 * l2; j++) {
-            operation_buffer = second_int.values[j / 2];
-            select_32_in_64(operation_buffer, j);
 
-            //  The actual product
-            operation_buffer *= operand_buffer;
+//  ----------------------------------------LITERALS----------------------------------------
 
-            //  Choose which buffer to update
-            if ((i + j) % 2 == 0) {
-                intermediate_buffer_0.values[(i + j) / 2] = operation_buffer;
-            }
-            else {
-                /*  If the 32 bits offset buffer is chosen, the 64 bits value sits on two 64 bits fields at the same time,
-                    so it has to be split in two and then added to each field individually.
-                */
+/**
+ * @brief Limbs of a bigint literal, computed at compile time.
+ * 
+ * @tparam Limbs Capacity.
+ */
+template<uint64_t Limbs>
+struct bigint_literal {
+    uint64_t limbs[Limbs] = {};
+    uint64_t size = 1;
+};
 
-                // Least signigicant bits become most significant bits of lower field.
-                intermediate_buffer_32.values[(i + j) / 2] += (operation_buffer % 0x100000000ULL) * 0x100000000ULL;
 
-                // Most significant bits become least significant bits of upper field.
-                intermediate_buffer_32.values[(i + j) / 2 + 1] += operation_buffer / 0x100000000ULL;
-            }
+/**
+ * @brief   Parses the characters of an integer literal into limbs, at compile time. Throws an invalid_argument on
+ *          characters that are not digits of the literal's base, which stops the compilation.
+ * 
+ * @tparam Limbs At least the number of limbs of the value.
+ * @tparam Digits 
+ * @return bigint_literal<Limbs> 
+ */
+template<uint64_t Limbs, char... Digits>
+constexpr bigint_literal<Limbs> parse_bigint_literal() {
+    const char digits[] = {Digits...};
+    uint64_t count = sizeof...(Digits), start = 0, base = 10;
+    if (count > 1 and digits[0] == '0') {
+        if (digits[1] == 'x' or digits[1] == 'X') {
+            base = 16;
+            start = 2;
+        }
+        else if (digits[1] == 'b' or digits[1] == 'B') {
+            base = 2;
+            start = 2;
+        }
+        else {
+            base = 8;
+            start = 1;
         }
-
-        //  Add both buffers to the result.
-        result_buffer += intermediate_buffer_0;
-        result_buffer += intermediate_buffer_32;
     }
 
-    //  Compute result sign.
-    result_buffer.sign = (int8_t) (sign * second_int.sign);
+    bigint_literal<Limbs> result;
+    for (uint64_t i = start; i < count; i++) {
+        char c = digits[i];
+        if (c == '\'') {
+            continue;
+        }
+        uint64_t digit = c >= '0' and c <= '9' ? (uint64_t) (c - '0')
+                       : c >= 'a' and c <= 'z' ? (uint64_t) (c - 'a' + 10)
+                       : c >= 'A' and c <= 'Z' ? (uint64_t) (c - 'A' + 10) : 36;
+        if (digit >= base) {
+            throw invalid_argument("Invalid digit in bigint literal.");
+        }
 
-    //  Clean useless 0-filled fields at the front of the number (probably none).
-    result_buffer.remove_empty_values();
-    return result_buffer;
+        //  limbs = limbs * base + digit, on the limbs used so far.
+        uint64_t carry = digit;
+        for (uint64_t j = 0; j < result.size; j++) {
+            result.limbs[j] = fixed_muladd_64(result.limbs[j], base, 0, carry);
+        }
+        if (carry != 0) {
+            result.limbs[result.size++] = carry;
+        }
+    }
+    return result;
 }
 
-bigint bigint::operator+(const bigint& second_int) const {
-    bigint new_bigint(*this);
-    new_bigint += second_int;
-    return new_bigint;
-}
 
-bigint bigint::operator-(const bigint& second_int) const {
-    bigint new_bigint(*this);
-    new_bigint -= second_int;
-    return new_bigint;
+template<char... Digits>
+bigint operator""_big() {
+    //  Every digit adds at most 4 bits, in any base.
+    static constexpr bigint_literal<sizeof...(Digits) * 4 / 64 + 1> literal = parse_bigint_literal<sizeof...(Digits) * 4 / 64 + 1, Digits...>();
+
+    bigint result;
+    result.values.assign(literal.limbs, literal.limbs + literal.size);
+    return result;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,186 @@
+#include "bigint.hpp"
+#include <iostream>
+#include <random>
+#include <tuple>
+
+using namespace std;
+
+/*  Checks limbs_divrem on operand shapes that reach the correction steps of every division algorithm: random limbs,
+    all-ones divisors (whose quotient estimates are the most often too large), dividends just below and at multiples
+    of the divisor, and divisors with a single bit. Each shape runs with the recursive algorithm forced down to a few
+    limbs, then with Newton's iteration forced down too, and every quotient and remainder is checked against
+    q * d + r == a and r < d. The reciprocal of limbs_invert_approx is checked against its bounds.
+    Exits with status 1 if any check fails:
+
+        g++ -std=c++17 -O2 src/test_div.cpp -o test_div && ./test_div
+*/
+
+
+/**
+ * @brief Returns size limbs of the given kind: "random", "ones" (all bits set) or "top" (only the highest bit set).
+ * 
+ * @param generator 
+ * @param size 
+ * @param kind 
+ * @return vector<uint64_t> 
+ */
+static vector<uint64_t> make_limbs(mt19937_64& generator, const uint64_t& size, const string& kind) {
+    vector<uint64_t> limbs(size);
+    for (uint64_t& limb : limbs) {
+        if (kind == "ones") {
+            limb = UINT64_MAX;
+        }
+        else if (kind == "top") {
+            limb = 0ULL;
+        }
+        else {
+            limb = generator();
+        }
+    }
+    if (kind == "top") {
+        limbs.back() = 1ULL << 63;
+    }
+    else if (limbs.back() == 0) {
+        limbs.back() = 1;
+    }
+    return limbs;
+}
+
+
+/**
+ * @brief Returns d * q + offset, where offset is -1, 0 or d - 1, with its leading zero limbs removed.
+ * 
+ * @param d 
+ * @param q 
+ * @param offset 
+ * @return vector<uint64_t> 
+ */
+static vector<uint64_t> make_dividend(const vector<uint64_t>& d, const vector<uint64_t>& q, const string& offset) {
+    vector<uint64_t> a(d.size() + q.size());
+    limbs_mul_basecase(a.data(), q.data(), q.size(), d.data(), d.size());
+    if (offset == "below") {
+        limbs_sub_1(a.data(), a.data(), a.size(), 1);
+    }
+    else if (offset == "last") {
+        limbs_add(a.data(), a.data(), a.size(), d.data(), d.size());
+        limbs_sub_1(a.data(), a.data(), a.size(), 1);
+    }
+    while (a.size() > d.size() and a.back() == 0) {
+        a.pop_back();
+    }
+    return a;
+}
+
+
+/**
+ * @brief   Divides a by d through limbs_divrem and reports whether the quotient q and remainder r satisfy
+ *          q * d + r == a and r < d, which defines them uniquely.
+ * 
+ * @param a 
+ * @param d 
+ * @param description Printed on failure.
+ * @return bool 
+ */
+static bool check_division(const vector<uint64_t>& a, const vector<uint64_t>& d, const string& description) {
+    vector<uint64_t> quotient(a.size() - d.size() + 1, 0xDEADBEEFULL), remainder(d.size(), 0xDEADBEEFULL);
+    limbs_divrem(quotient.data(), remainder.data(), a.data(), a.size(), d.data(), d.size());
+
+    vector<uint64_t> product(quotient.size() + d.size());
+    limbs_mul_basecase(product.data(), quotient.data(), quotient.size(), d.data(), d.size());
+    uint64_t carry = limbs_add(product.data(), product.data(), product.size(), remainder.data(), remainder.size());
+
+    bool exact = carry == 0 and limbs_cmp(remainder.data(), d.data(), d.size()) < 0
+                 and equal(a.begin(), a.end(), product.begin())
+                 and all_of(product.begin() + a.size(), product.end(), [](uint64_t limb) { return limb == 0; });
+    if (not exact) {
+        cout << "FAILED: " << description << "\n";
+    }
+    return exact;
+}
+
+
+/**
+ * @brief   Computes the reciprocal of the normalized d through limbs_invert_approx and reports whether
+ *          d * x < B^2n <= d * (x + 2).
+ * 
+ * @param d 
+ * @param description Printed on failure.
+ * @return bool 
+ */
+static bool check_reciprocal(const vector<uint64_t>& d, const string& description) {
+    uint64_t n = d.size();
+    vector<uint64_t> x(n + 1), scratch(limbs_invert_scratch_size(n));
+    limbs_invert_approx(x.data(), d.data(), n, scratch.data());
+
+    //  d * x must be below B^2n, and d * x + 2 * d at least B^2n.
+    vector<uint64_t> product(2 * n + 1);
+    limbs_mul_basecase(product.data(), x.data(), n + 1, d.data(), n);
+    bool below = product[2 * n] == 0;
+    limbs_add(product.data(), product.data(), 2 * n + 1, d.data(), n);
+    limbs_add(product.data(), product.data(), 2 * n + 1, d.data(), n);
+    bool above = product[2 * n] != 0;
+
+    if (not (below and above and x[n] == 1)) {
+        cout << "FAILED: " << description << "\n";
+        return false;
+    }
+    return true;
+}
+
+
+int main() {
+    mt19937_64 generator(4057);
+    uint64_t checks = 0, failures = 0;
+    vector<string> kinds = {"random", "ones", "top"};
+    vector<string> offsets = {"below", "exact", "last"};
+    vector<uint64_t> sizes = {1, 2, 3, 5, 8, 9, 17, 31, 40, 64, 100, 128, 257, 600, 1024};
+
+    //  The recursive algorithm from 8 limbs on, alone, then with Newton's iteration from 24 limbs on, then with NTT products
+    //  from 16 limbs on too so that the cyclic products of the iteration are reached.
+    uint64_t dc_threshold = DIVISION_DC_THRESHOLD, newton_threshold = DIVISION_NEWTON_THRESHOLD, ntt_threshold = NTT_THRESHOLD;
+    vector<tuple<string, uint64_t, uint64_t>> settings = {
+        {"recursive", newton_threshold, ntt_threshold}, {"Newton", 24, ntt_threshold}, {"Newton and NTT", 24, 16}
+    };
+    DIVISION_DC_THRESHOLD = 8;
+    for (const auto& [setting, newton, ntt] : settings) {
+        DIVISION_NEWTON_THRESHOLD = newton;
+        NTT_THRESHOLD = ntt;
+
+        for (const string& kind : kinds) {
+            for (uint64_t size : sizes) {
+                vector<uint64_t> d = make_limbs(generator, size, kind);
+                d.back() |= kind == "random" and size % 2 == 0 ? 1ULL << 63 : 0ULL;
+                string name = setting + ", " + kind + " divisor of " + to_string(size) + " limbs";
+
+                //  Short and long quotients: a single block, a partial block, and several blocks with an odd one.
+                for (uint64_t quotient_size : {uint64_t(1), size / 2 + 1, size, 3 * size + 5}) {
+                    for (const string& offset : offsets) {
+                        vector<uint64_t> q = make_limbs(generator, quotient_size, kind == "top" ? "ones" : kind);
+                        vector<uint64_t> a = make_dividend(d, q, offset);
+                        checks += 1;
+                        failures += !check_division(a, d, name + " by " + to_string(quotient_size) + " limbs, " + offset);
+                    }
+                }
+
+                //  All-ones dividends, the largest for their size.
+                vector<uint64_t> ones = make_limbs(generator, 2 * size + 1, "ones");
+                checks += 1;
+                failures += !check_division(ones, d, name + ", all-ones dividend");
+
+                //  Reciprocals of normalized divisors, through the base case and the iteration.
+                if (size >= 2) {
+                    vector<uint64_t> normalized = d;
+                    normalized.back() |= 1ULL << 63;
+                    checks += 1;
+                    failures += !check_reciprocal(normalized, "reciprocal, " + name);
+                }
+            }
+        }
+    }
+    DIVISION_DC_THRESHOLD = dc_threshold;
+    DIVISION_NEWTON_THRESHOLD = newton_threshold;
+    NTT_THRESHOLD = ntt_threshold;
+
+    cout << checks - failures << " of " << checks << " division checks passed.\n";
+    return failures > 0 ? 1 : 0;
+}
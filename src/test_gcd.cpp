@@ -0,0 +1,163 @@
+#include "bigint.hpp"
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+using namespace std;
+
+/*  Checks gcd, extended_gcd and mod_inverse with the half-gcd thresholds forced down, so that the half-gcd recursion is
+    reached on small operands, on inputs that stress its splits: equal operands, consecutive integers, neighbouring
+    Fibonacci numbers (whose quotients are all 1) and random pairs with and without a common factor.
+    A gcd g is checked without a reference implementation: g divides a and b, and a * x + b * y == g for the
+    cofactors of extended_gcd, so every common divisor of a and b divides g. Exits with status 1 if any check fails:
+
+        g++ -std=c++17 -O2 src/test_gcd.cpp -o test_gcd && ./test_gcd
+*/
+
+
+/**
+ * @brief Returns a random non-negative number of size limbs.
+ * 
+ * @param generator 
+ * @param size 
+ * @return bigint 
+ */
+static bigint make_number(mt19937_64& generator, const uint64_t& size) {
+    bigint number;
+    for (uint64_t i = 0; i < size; i++) {
+        number <<= 64;
+        number += generator();
+    }
+    return number;
+}
+
+
+/**
+ * @brief   Computes gcd(a, b) and extended_gcd(a, b, x, y), and reports whether both agree, the gcd divides a and b,
+ *          the cofactors satisfy a * x + b * y == gcd, and the gcd equals expected when it is not negative.
+ * 
+ * @param a 
+ * @param b 
+ * @param expected -1 when unknown.
+ * @param description Printed on failure.
+ * @return bool 
+ */
+static bool check_gcd(const bigint& a, const bigint& b, const bigint& expected, const string& description) {
+    bigint g = gcd(a, b);
+    bigint x, y;
+    bigint extended = extended_gcd(a, b, x, y);
+
+    bool exact = g == extended and g >= 0 and a * x + b * y == g;
+    if (exact and g != 0) {
+        exact = a % g == 0 and b % g == 0;
+    }
+    if (exact and expected >= 0) {
+        exact = g == expected;
+    }
+    if (not exact) {
+        cout << "FAILED: " << description << "\n";
+    }
+    return exact;
+}
+
+
+/**
+ * @brief   Computes the inverse of a modulo modulus, and reports whether it is in [0, modulus), its product by a is 1
+ *          modulo modulus and its own inverse is a mod modulus. When a and modulus are not coprime, reports whether
+ *          mod_inverse throws a domain_error instead.
+ * 
+ * @param a 
+ * @param modulus Positive.
+ * @param description Printed on failure.
+ * @return bool 
+ */
+static bool check_inverse(const bigint& a, const bigint& modulus, const string& description) {
+    bool exact;
+    if (gcd(a, modulus) != 1) {
+        try {
+            mod_inverse(a, modulus);
+            exact = false;
+        }
+        catch (const domain_error&) {
+            exact = true;
+        }
+    }
+    else {
+        bigint inverse = mod_inverse(a, modulus);
+        bigint a_reduced = a % modulus;
+        if (a_reduced < 0) {
+            a_reduced += modulus;
+        }
+        exact = inverse >= 0 and inverse < modulus and (a * inverse - 1) % modulus == 0
+                and mod_inverse(inverse, modulus) == a_reduced % modulus;
+    }
+
+    if (not exact) {
+        cout << "FAILED: " << description << "\n";
+    }
+    return exact;
+}
+
+
+int main() {
+    mt19937_64 generator(1597);
+    uint64_t checks = 0, failures = 0;
+    vector<uint64_t> sizes = {1, 2, 3, 5, 17, 40, 100, 301, 1000};
+
+    //  Half-gcd steps from 4 limbs on, recursing from 8 limbs on.
+    uint64_t hgcd_threshold = HGCD_THRESHOLD, gcd_hgcd_threshold = GCD_HGCD_THRESHOLD;
+    HGCD_THRESHOLD = 8;
+    GCD_HGCD_THRESHOLD = 4;
+
+    for (uint64_t size : sizes) {
+        string name = to_string(size) + " limbs";
+        bigint x = make_number(generator, size), y = make_number(generator, size);
+        bigint factor = make_number(generator, size / 2 + 1);
+
+        checks += 9;
+        failures += !check_gcd(x, x, x, "gcd(x, x), " + name);
+        failures += !check_gcd(x, x + 1, 1, "gcd(x, x + 1), " + name);
+        failures += !check_gcd(x + 1, x, 1, "gcd(x + 1, x), " + name);
+        failures += !check_gcd(-x, x, x, "gcd(-x, x), " + name);
+        failures += !check_gcd(x, 0, x, "gcd(x, 0), " + name);
+        failures += !check_gcd(x, y, -1, "random pair, " + name);
+        failures += !check_gcd(-x, y, -1, "random pair with a negative operand, " + name);
+        failures += !check_gcd(x * factor, y * factor, -1, "random pair with a common factor, " + name);
+        failures += !check_gcd(x * factor, factor, factor, "multiple of the other operand, " + name);
+
+        //  Unbalanced operands.
+        bigint small = make_number(generator, size / 3 + 1);
+        checks += 2;
+        failures += !check_gcd(x * y, small, -1, "unbalanced pair, " + name);
+        failures += !check_gcd(small, x * y + small, -1, "unbalanced pair, smaller first, " + name);
+
+        //  Inverses modulo random and odd moduli, and an operand that is not invertible.
+        bigint modulus = y + 2;
+        checks += 4;
+        failures += !check_inverse(x, modulus, "inverse modulo a random modulus, " + name);
+        failures += !check_inverse(x, modulus | 1, "inverse modulo an odd modulus, " + name);
+        failures += !check_inverse(-x, modulus | 1, "inverse of a negative value, " + name);
+        failures += !check_inverse(factor * 2, factor * 6, "non invertible value, " + name);
+    }
+
+    //  Neighbouring Fibonacci numbers: the longest Euclid sequences for their size, every quotient being 1.
+    bigint previous = 0, current = 1;
+    for (uint64_t n = 1; n <= 100000; n++) {
+        bigint next = previous + current;
+        previous = std::move(current);
+        current = std::move(next);
+        if (n == 90 or n == 1000 or n == 4000 or n == 20000 or n == 100000) {
+            string name = "Fibonacci numbers " + to_string(n) + " and " + to_string(n + 1);
+            checks += 3;
+            failures += !check_gcd(current, previous, 1, name);
+            failures += !check_gcd(previous, current, 1, name + ", smaller first");
+            failures += !check_inverse(previous, current, "inverse of " + name);
+        }
+    }
+
+    HGCD_THRESHOLD = hgcd_threshold;
+    GCD_HGCD_THRESHOLD = gcd_hgcd_threshold;
+
+    cout << checks - failures << " of " << checks << " gcd checks passed.\n";
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+#include "bigint.hpp"
+#include <iostream>
+#include <random>
+
+using namespace std;
+
+/*  Checks NTT products against the schoolbook kernel, on operand shapes that stress the transforms: random limbs,
+    all ones (the largest coefficients the CRT recombination can get), single bits, unbalanced operands and squares.
+    Exits with status 1 if any product differs:
+
+        g++ -std=c++17 -O2 src/test_ntt.cpp -o test_ntt && ./test_ntt
+*/
+
+
+/**
+ * @brief Returns size limbs of the given kind: "random", "ones" (all bits set) or "sparse" (a single bit per limb).
+ * 
+ * @param generator 
+ * @param size 
+ * @param kind 
+ * @return vector<uint64_t> 
+ */
+static vector<uint64_t> make_limbs(mt19937_64& generator, const uint64_t& size, const string& kind) {
+    vector<uint64_t> limbs(size);
+    for (uint64_t& limb : limbs) {
+        if (kind == "ones") {
+            limb = UINT64_MAX;
+        }
+        else if (kind == "sparse") {
+            limb = 1ULL << (generator() % 64);
+        }
+        else {
+            limb = generator();
+        }
+    }
+    return limbs;
+}
+
+
+/**
+ * @brief   Multiplies a by b (or squares a when b is empty) through limbs_mul_ntt and limbs_mul_basecase, and reports
+ *          whether both products are equal.
+ * 
+ * @param a 
+ * @param b 
+ * @param description Printed on failure.
+ * @return bool 
+ */
+static bool check_product(const vector<uint64_t>& a, const vector<uint64_t>& b, const string& description) {
+    bool square = b.empty();
+    const vector<uint64_t>& second = square ? a : b;
+    uint64_t result_size = a.size() + second.size();
+    vector<uint64_t> expected(result_size), result(result_size, 0xDEADBEEFULL);
+
+    if (square) {
+        limbs_sqr_basecase(expected.data(), a.data(), a.size());
+    }
+    else {
+        limbs_mul_basecase(expected.data(), a.data(), a.size(), second.data(), second.size());
+    }
+    limbs_mul_ntt(result.data(), a.data(), a.size(), second.data(), second.size());
+
+    if (result != expected) {
+        cout << "FAILED: " << description << "\n";
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief   Multiplies a by b through limbs_mul (or limbs_sqr when b is empty) with NTT_THRESHOLD forced down, so that
+ *          the NTT is reached from the dispatcher and at every level of the recursion, and compares with the result
+ *          of the schoolbook kernel.
+ * 
+ * @param a 
+ * @param b 
+ * @param description Printed on failure.
+ * @return bool 
+ */
+static bool check_dispatch(const vector<uint64_t>& a, const vector<uint64_t>& b, const string& description) {
+    bool square = b.empty();
+    const vector<uint64_t>& second = square ? a : b;
+    uint64_t result_size = a.size() + second.size();
+    vector<uint64_t> expected(result_size), result(result_size);
+    limbs_mul_basecase(expected.data(), a.data(), a.size(), second.data(), second.size());
+
+    uint64_t threshold = NTT_THRESHOLD;
+    NTT_THRESHOLD = 8;
+    if (square) {
+        limbs_sqr(result.data(), a.data(), a.size());
+    }
+    else {
+        limbs_mul(result.data(), a.data(), a.size(), second.data(), second.size());
+    }
+    NTT_THRESHOLD = threshold;
+
+    if (result != expected) {
+        cout << "FAILED: " << description << "\n";
+        return false;
+    }
+    return true;
+}
+
+
+int main() {
+    mt19937_64 generator(701);
+    uint64_t checks = 0, failures = 0;
+    vector<string> kinds = {"random", "ones", "sparse"};
+    vector<uint64_t> sizes = {1, 2, 3, 4, 7, 8, 31, 64, 100, 255, 256, 257, 1000, 2048, 3001};
+
+    for (const string& kind : kinds) {
+        for (uint64_t size : sizes) {
+            vector<uint64_t> a = make_limbs(generator, size, kind), b = make_limbs(generator, size, kind);
+            string name = kind + " " + to_string(size) + " limbs";
+
+            checks += 3;
+            failures += !check_product(a, b, "product, " + name);
+            failures += !check_product(a, {}, "square, " + name);
+            failures += !check_dispatch(a, b, "dispatched product, " + name);
+
+            //  Unbalanced: the transform size is set by the sum of both sizes.
+            for (uint64_t ratio : {2, 5, 17}) {
+                vector<uint64_t> large = make_limbs(generator, size * ratio + generator() % 7, kind);
+                string shape = name + " by " + to_string(large.size()) + " limbs";
+                checks += 2;
+                failures += !check_product(large, a, "unbalanced product, " + shape);
+                failures += !check_dispatch(large, a, "dispatched unbalanced product, " + shape);
+            }
+        }
+    }
+
+    //  Mixed operands: all ones by random, random by single bits.
+    for (uint64_t size : sizes) {
+        vector<uint64_t> ones = make_limbs(generator, size, "ones"), random = make_limbs(generator, size + 3, "random");
+        vector<uint64_t> sparse = make_limbs(generator, 2 * size, "sparse");
+        checks += 3;
+        failures += !check_product(ones, random, "ones by random, " + to_string(size) + " limbs");
+        failures += !check_product(random, sparse, "random by sparse, " + to_string(size) + " limbs");
+        failures += !check_dispatch(ones, {}, "dispatched square of ones, " + to_string(size) + " limbs");
+    }
+
+    cout << checks - failures << " of " << checks << " NTT checks passed.\n";
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+#include "bigint.hpp"
+#include <iostream>
+#include <random>
+
+using namespace std;
+
+/*  Checks parallel multiplication against serial results: product, binomial, *= (products and squares) and addmul are
+    computed once on a single thread with parallel multiplication disabled, then again with it enabled for several
+    thread counts. PARALLEL_MUL_THRESHOLD and the multiplication thresholds are forced down so that Karatsuba, Toom-3
+    and NTT sub-products all run in parallel, nested in each other and in product trees. Exits with status 1 if any
+    result differs:
+
+        g++ -std=c++17 -O2 -pthread src/test_parallel.cpp -o test_parallel && ./test_parallel
+*/
+
+
+/**
+ * @brief Returns a random number of size limbs, negative if negative is set.
+ * 
+ * @param generator 
+ * @param size 
+ * @param negative 
+ * @return bigint 
+ */
+static bigint make_number(mt19937_64& generator, const uint64_t& size, const bool& negative) {
+    bigint number;
+    for (uint64_t i = 0; i < size; i++) {
+        number <<= 64;
+        number += generator();
+    }
+    return negative ? -number : number;
+}
+
+
+/**
+ * @brief   Computes every operation checked by the test, in a fixed order, with the current thread count and
+ *          parallel multiplication setting.
+ * 
+ * @param operands Random operands, used in pairs.
+ * @param factors Factors of the product tree.
+ * @return vector<bigint> 
+ */
+static vector<bigint> run_operations(const vector<bigint>& operands, const vector<bigint>& factors) {
+    vector<bigint> results;
+    results.push_back(product(factors));
+    results.push_back(binomial(6000, 2500));
+    results.push_back(factorial(3000));
+
+    for (uint64_t i = 0; i + 1 < operands.size(); i += 2) {
+        bigint x = operands[i];
+        x *= operands[i + 1];
+        results.push_back(x);
+
+        bigint square = operands[i];
+        square *= square;
+        results.push_back(square);
+
+        bigint accumulator = operands[i + 1];
+        accumulator.addmul(operands[i], operands[i + 1]);
+        accumulator.addmul(operands[i], operands[i]);
+        results.push_back(accumulator);
+    }
+    return results;
+}
+
+
+int main() {
+    mt19937_64 generator(3001);
+    uint64_t checks = 0, failures = 0;
+
+    //  Balanced, unbalanced and negative operands, from Karatsuba to NTT sizes once the thresholds are lowered.
+    vector<bigint> operands;
+    for (uint64_t size : {20, 64, 150, 400, 1000, 2500}) {
+        operands.push_back(make_number(generator, size, false));
+        operands.push_back(make_number(generator, size + generator() % 5, size % 2 == 0));
+        operands.push_back(make_number(generator, 3 * size + 1, true));
+        operands.push_back(make_number(generator, size, false));
+    }
+    vector<bigint> factors;
+    for (uint64_t i = 0; i < 40; i++) {
+        factors.push_back(make_number(generator, 1 + generator() % 200, i % 7 == 0));
+    }
+
+    uint64_t karatsuba = KARATSUBA_THRESHOLD, toom3 = TOOM3_THRESHOLD, karatsuba_square = KARATSUBA_SQUARE_THRESHOLD;
+    uint64_t toom3_square = TOOM3_SQUARE_THRESHOLD, ntt = NTT_THRESHOLD, parallel = PARALLEL_MUL_THRESHOLD;
+    KARATSUBA_THRESHOLD = 8;
+    TOOM3_THRESHOLD = 24;
+    KARATSUBA_SQUARE_THRESHOLD = 8;
+    TOOM3_SQUARE_THRESHOLD = 24;
+    NTT_THRESHOLD = 600;
+    PARALLEL_MUL_THRESHOLD = 16;
+
+    set_bigint_thread_count(1);
+    set_bigint_parallel_multiplication(false);
+    vector<bigint> expected = run_operations(operands, factors);
+
+    set_bigint_parallel_multiplication(true);
+    for (uint64_t threads : {1, 2, 3, 4, 8}) {
+        set_bigint_thread_count(threads);
+        vector<bigint> results = run_operations(operands, factors);
+        for (uint64_t i = 0; i < expected.size(); i++) {
+            checks += 1;
+            if (results[i] != expected[i]) {
+                failures += 1;
+                cout << "FAILED: result " << i << " with " << threads << " threads\n";
+            }
+        }
+    }
+
+    set_bigint_parallel_multiplication(false);
+    set_bigint_thread_count(0);
+    KARATSUBA_THRESHOLD = karatsuba;
+    TOOM3_THRESHOLD = toom3;
+    KARATSUBA_SQUARE_THRESHOLD = karatsuba_square;
+    TOOM3_SQUARE_THRESHOLD = toom3_square;
+    NTT_THRESHOLD = ntt;
+    PARALLEL_MUL_THRESHOLD = parallel;
+
+    cout << checks - failures << " of " << checks << " parallel multiplication checks passed.\n";
+    return failures > 0 ? 1 : 0;
+}